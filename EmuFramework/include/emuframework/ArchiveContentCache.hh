@@ -0,0 +1,86 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/defs.hh>
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/util/string/CStringView.hh>
+
+namespace IG
+{
+class ApplicationContext;
+class MapIO;
+class FileIO;
+}
+#endif
+#ifndef IG_USE_MODULE_STD
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#endif
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Stores the decompressed entries of large archives in the app's cache directory so later
+// launches can open the extracted files directly instead of inflating the archive again.
+// Each archive gets its own directory keyed by its path and last write time, with a manifest
+// recording the entries' sizes and CRCs. Directories are evicted least recently used first
+// once the total size exceeds the configured limit. Archives whose contents don't fit in the
+// limit leave a marker file with the same key so they aren't extracted again on every launch.
+class ArchiveContentCache
+{
+public:
+	static constexpr uint16_t defaultMaxMiB = 2048;
+	// smaller archives decompress quickly enough that caching them only wastes space
+	static constexpr size_t minArchiveBytes = 16 * 1024 * 1024;
+
+	struct Entry
+	{
+		FS::FileString name;
+		size_t size{};
+		uint32_t crc32{};
+	};
+
+	struct Content
+	{
+		FS::PathString directory;
+		std::vector<Entry> entries;
+
+		explicit operator bool() const { return directory.size(); }
+		FS::PathString filePath(std::string_view name) const;
+	};
+
+	Content content(ApplicationContext, CStringView archivePath);
+	void clear(ApplicationContext);
+	void setMaxMiB(uint16_t mib) { maxMiB_ = mib; }
+	uint16_t maxMiB() const { return maxMiB_; }
+	bool isEnabled() const { return maxMiB_; }
+	bool readConfig(MapIO &, unsigned key);
+	void writeConfig(FileIO &) const;
+
+private:
+	uint16_t maxMiB_{defaultMaxMiB};
+
+	size_t maxBytes() const { return size_t(maxMiB_) * 1024 * 1024; }
+	Content extract(ApplicationContext, CStringView archivePath, CStringView dir);
+	void evict(CStringView cachePath, std::string_view keepDir);
+};
+
+}
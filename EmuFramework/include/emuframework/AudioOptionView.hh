@@ -44,6 +44,7 @@ protected:
 	TextMenuItem soundBuffersItem[7];
 	MultiChoiceMenuItem soundBuffers;
 	BoolMenuItem addSoundBuffersOnUnderrun;
+	BoolMenuItem rateControl;
 	StaticArrayList<TextMenuItem, 5> audioRateItem;
 	MultiChoiceMenuItem audioRate;
 	ConditionalMember<Audio::Manager::HAS_SOLO_MIX, BoolMenuItem> audioSoloMix;
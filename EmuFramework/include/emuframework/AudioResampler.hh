@@ -0,0 +1,59 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/audio/Format.hh>
+#endif
+#ifndef IG_USE_MODULE_STD
+#include <memory>
+#endif
+
+struct SpeexResamplerState_;
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Windowed-sinc resampler stage that converts interleaved frames by a ratio that can be changed
+// between calls without discontinuities, used for fast-forward and dynamic rate control
+class AudioResampler
+{
+public:
+	static constexpr int defaultQuality = 3;
+
+	constexpr AudioResampler() = default;
+	AudioResampler(Audio::Format, int quality = defaultQuality);
+	void setRatio(double inputFramesPerOutputFrame);
+	double ratio() const { return ratio_; }
+	// returns the number of frames written to dest, any input that doesn't fit is dropped
+	size_t process(void *dest, size_t destFrames, const void *src, size_t srcFrames);
+	void reset();
+	explicit operator bool() const { return bool(state); }
+
+protected:
+	struct StateDeleter
+	{
+		void operator()(SpeexResamplerState_ *) const;
+	};
+
+	std::unique_ptr<SpeexResamplerState_, StateDeleter> state;
+	double ratio_{1.};
+	Audio::SampleFormat sampleFormat;
+};
+
+}
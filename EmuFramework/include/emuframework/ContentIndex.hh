@@ -0,0 +1,81 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/defs.hh>
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/string/CStringView.hh>
+#endif
+#ifndef IG_USE_MODULE_STD
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#endif
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Keeps the entries of directories opened in the file picker in the app's cache directory so
+// large folders on slow storage don't need to be read again until they change. A directory's
+// entries are reused while its last write time, which changes whenever an entry is added,
+// removed, or renamed, matches the one recorded when it was indexed. Only the most recently
+// used directories are kept.
+class ContentIndex
+{
+public:
+	static constexpr size_t maxDirectories = 256;
+
+	void forEachInDirectory(ApplicationContext, CStringView path, DirectoryEntryDelegate);
+	void save(ApplicationContext);
+
+private:
+	struct Entry
+	{
+		uint32_t dataOffset{};
+		uint16_t pathPrefixSize{};
+		uint16_t pathSuffixSize{};
+		uint16_t nameSize{};
+		FS::file_type type{};
+	};
+
+	struct Directory
+	{
+		std::string path;
+		WallClockTimePoint lastWriteTime{};
+		std::vector<Entry> entries;
+		// each entry's path after the part shared with the directory path, followed by its name
+		std::string entryData;
+
+		bool forEachEntry(DirectoryEntryDelegate) const;
+	};
+
+	std::mutex mutex;
+	std::vector<Directory> dirs; // least recently used first
+	bool isLoaded{};
+	bool isDirty{};
+
+	void load(ApplicationContext);
+	static bool index(Directory &, ApplicationContext, DirectoryEntryDelegate);
+};
+
+}
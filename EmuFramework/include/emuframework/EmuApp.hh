@@ -26,6 +26,9 @@
 #include <emuframework/AutosaveManager.hh>
 #include <emuframework/RecentContent.hh>
 #include <emuframework/RewindManager.hh>
+#include <emuframework/RunAheadManager.hh>
+#include <emuframework/ArchiveContentCache.hh>
+#include <emuframework/ContentIndex.hh>
 #include <emuframework/AssetManager.hh>
 #include <emuframework/InputManager.hh>
 #include <emuframework/AppMeta.hh>
@@ -316,12 +319,16 @@ public:
 	Data::FontManager fontManager;
 	mutable Gfx::Renderer renderer;
 	ViewManager viewManager;
+	FrameTrace frameTrace;
 	EmuAudio audio;
 	EmuVideo video;
 	EmuVideoLayer videoLayer;
 	AutosaveManager autosaveManager{*this};
 	InputManager inputManager;
 	RewindManager rewindManager{*this};
+	RunAheadManager runAheadManager;
+	ArchiveContentCache archiveContentCache;
+	ContentIndex contentIndex;
 	AssetManager assetManager;
 	FrameTimingStats frameTimingStats;
 	OutputTimingManager outputTimingManager;
@@ -240,6 +240,20 @@ size_t EmuSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags)
 	return static_cast<MainSystem*>(this)->writeState(buff, flags);
 }
 
+void EmuSystem::readStateStream(EmuApp &app, IO &io)
+{
+	if(&MainSystem::readStateStream != &EmuSystem::readStateStream)
+		return static_cast<MainSystem*>(this)->readStateStream(app, io);
+	readState(app, io.buffer(IOBufferMode::Release));
+}
+
+void EmuSystem::writeStateStream(IO &io)
+{
+	if(&MainSystem::writeStateStream != &EmuSystem::writeStateStream)
+		return static_cast<MainSystem*>(this)->writeStateStream(io);
+	io.write(saveState().span());
+}
+
 void EmuSystem::clearInputBuffers()
 {
 	static_cast<MainSystem*>(this)->clearInputBuffers();
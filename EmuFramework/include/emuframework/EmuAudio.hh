@@ -15,7 +15,10 @@
 	You should have received a copy of the GNU General Public License
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
+#include <emuframework/defs.hh>
 #include <emuframework/EmuOptions.hh>
+#include <emuframework/AudioResampler.hh>
+#include <emuframework/FrameTrace.hh>
 #ifndef IG_USE_MODULE_IMAGINE
 #include <imagine/audio/OutputStream.hh>
 #include <imagine/audio/Manager.hh>
@@ -26,6 +29,7 @@
 #ifndef IG_USE_MODULE_STD
 #include <memory>
 #include <atomic>
+#include <limits>
 #endif
 
 #ifndef IG_USE_MODULE_IMAGINE
@@ -52,29 +56,28 @@ struct AudioFlags
 
 inline constexpr AudioFlags defaultAudioFlags{.enabled = 1, .enabledDuringAltSpeed = 1};
 
+// max output rate adjustment applied to keep the buffer near its fill target
+inline constexpr double maxRateControlDelta = .005;
+
 class EmuAudio
 {
 public:
-	enum class AudioWriteState : uint8_t
-	{
-		BUFFER,
-		ACTIVE,
-		UNDERRUN,
-		MULTI_UNDERRUN
-	};
-
-	EmuAudio(ApplicationContext);
+	EmuAudio(ApplicationContext, FrameTrace &);
 	void open();
 	void start(FloatSeconds bufferDuration);
 	void stop();
 	void close();
 	void flush();
+	void openWithoutOutput(FloatSeconds bufferDuration);
+	void discardFrames() { rBuff.clear(); }
 	void writeFrames(const void *samples, size_t framesToWrite);
 	void setRate(int rate);
 	int rate() const { return rate_; }
 	int maxRate() const { return defaultRate; }
 	void setStereo(bool on);
 	void setSpeedMultiplier(double speed);
+	void setRateControl(bool on) { rateControl_ = on; }
+	bool rateControl() const { return rateControl_; }
 	float volume() const { return currentVolume; }
 	bool setMaxVolume(int8_t vol);
 	int8_t maxVolume() const { return std::round(maxVolume_ * 100.f); }
@@ -88,12 +91,34 @@ public:
 	explicit operator bool() const { return bool(rBuff.capacity()); }
 	void writeConfig(FileIO &) const;
 	bool readConfig(MapIO &, unsigned key);
+	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+	AudioStats stats() const;
+	void resetStats();
+	#endif
 
 	Audio::Manager manager;
 protected:
 	Audio::OutputStream audioStream;
+	FrameTrace *frameTracePtr;
 	RingBuffer<uint8_t, RingBufferConf{.mirrored = true}> rBuff;
+	AudioResampler resampler;
+	// The emulation thread and audio callback each only write their own counters on separate
+	// cache lines. The callback reads from the buffer while readsStartedAt matches its underrun
+	// count, so an underrun pauses reads until the emulation thread refills the buffer.
+	static constexpr uint32_t readsStopped = std::numeric_limits<uint32_t>::max();
+	alignas(64) std::atomic_uint32_t underruns{};
+	std::atomic_uint32_t multiUnderruns{};
 	SteadyClockTimePoint lastUnderrunTime{};
+	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+	std::atomic_uint32_t callbacks{};
+	std::atomic_size_t callbackFrames{};
+	#endif
+	alignas(64) std::atomic_uint32_t readsStartedAt{readsStopped};
+	uint32_t seenMultiUnderruns{};
+	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+	std::atomic_uint32_t overruns{};
+	AudioStats statsBase{};
+	#endif
 	double speedMultiplier{1.};
 	size_t targetBufferFillBytes{};
 	size_t bufferIncrementBytes{};
@@ -101,11 +126,11 @@ protected:
 	int rate_;
 	float maxVolume_{1.};
 	float currentVolume{1.};
-	std::atomic<AudioWriteState> audioWriteState{AudioWriteState::BUFFER};
 	int8_t channels{2};
 	AudioFlags flags{defaultAudioFlags};
 	ConditionalMember<Audio::Config::MULTIPLE_SYSTEM_APIS, Audio::Api> audioAPI{};
 	bool addSoundBuffersOnUnderrun{};
+	bool rateControl_{};
 public:
 	bool addSoundBuffersOnUnderrunSetting{};
 	Property<int8_t, CFGKEY_SOUND_BUFFERS,
@@ -117,7 +142,11 @@ public:
 	size_t framesWritten() const;
 	size_t framesCapacity() const;
 	bool shouldStartAudioWrites(size_t bytesToWrite = 0) const;
+	void startReads() { readsStartedAt.store(underruns.load(std::memory_order_acquire), std::memory_order_release); }
+	void stopReads() { readsStartedAt.store(readsStopped, std::memory_order_release); }
 	void resizeAudioBuffer(size_t targetBufferFillBytes);
+	double rateControlAdjustment() const;
+	size_t writeResampledFrames(const void *samples, size_t frames, Audio::Format);
 	void updateVolume();
 	void updateAddBuffersOnUnderrun();
 };
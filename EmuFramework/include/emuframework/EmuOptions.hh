@@ -91,7 +91,11 @@ enum ConfigKey { CFGKEY_SOUND = 0, CFGKEY_TOUCH_CONTROL_DISPLAY = 1,
 	CFGKEY_REWIND_STATES = 118, CFGKEY_REWIND_TIMER_SECS = 119,
 	CFGKEY_FRAME_CLOCK = 120, CFGKEY_INPUT_DEVICE_CONTENT_CONFIGS = 121,
 	CFGKEY_SHOW_FRAME_TIMING_STATS = 122, CFGKEY_OUTPUT_FRAME_RATE_MODE = 123,
-	CFGKEY_SAVE_STATE_SLOT = 124,
+	CFGKEY_SAVE_STATE_SLOT = 124, CFGKEY_REWIND_STORAGE_MODE = 125,
+	CFGKEY_REWIND_FRAME_INTERVAL = 126,
+	CFGKEY_RUN_AHEAD_FRAMES = 127, CFGKEY_RUN_AHEAD_MODE = 128,
+	CFGKEY_AUDIO_RATE_CONTROL = 129, CFGKEY_ARCHIVE_CACHE_SIZE = 130,
+	CFGKEY_INPUT_THREAD = 131,
 	// 256+ is reserved
 };
 
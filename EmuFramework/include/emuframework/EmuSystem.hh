@@ -16,6 +16,7 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <emuframework/EmuTiming.hh>
+#include <emuframework/SubFrameInput.hh>
 #include <emuframework/VController.hh>
 #include <emuframework/EmuInput.hh>
 #include <emuframework/AppMeta.hh>
@@ -99,6 +100,9 @@ inline constexpr const char *optionUserPathContentToken = ":CONTENT:";
 struct SaveStateFlags
 {
 	uint8_t uncompressed:1{};
+	// buffer holds the previous incremental state from the same caller, systems that
+	// track RAM writes may skip copying unmodified memory, set together with uncompressed
+	uint8_t incremental:1{};
 };
 
 class EmuSystem
@@ -159,6 +163,8 @@ public:
 	void onStart();
 	void onStop();
 	void closeSystem();
+	void readStateStream(EmuApp &, IO &);
+	void writeStateStream(IO &);
 	bool onPointerInputStart(const Input::MotionEvent&, Input::DragTrackerState, WindowRect gameRect);
 	bool onPointerInputUpdate(const Input::MotionEvent&, Input::DragTrackerState current, Input::DragTrackerState previous, WindowRect gameRect);
 	bool onPointerInputEnd(const Input::MotionEvent&, Input::DragTrackerState, WindowRect gameRect);
@@ -210,6 +216,7 @@ public:
 	FS::PathString contentDirectory(std::string_view name) const;
 	FS::PathString contentFilePath(std::string_view ext) const;
 	const auto &contentLocation() const { return contentLocation_; }
+	const auto &contentCacheDirectory() const { return contentCacheDirectory_; }
 	FS::FileString contentNameExt(std::string_view ext) const
 	{
 		FS::FileString name{contentName_};
@@ -320,6 +327,7 @@ protected:
 	ApplicationContext appCtx{};
 public:
 	EmuTiming timing;
+	SubFrameInput subFrameInput;
 protected:
 	double audioFramesPerVideoFrameFloat{};
 	double currentAudioFramesPerVideoFrame{};
@@ -332,6 +340,7 @@ protected:
 	FS::PathString contentLocation_; // full path or URI to content
 	FS::FileString contentFileName_; // name + extension of content, inside archive if any
 	FS::FileString contentName_; // name of content from the original location without extension
+	FS::PathString contentCacheDirectory_; // directory of the extracted archive contents, if cached
 	std::string contentDisplayName_; // more descriptive content name set by system
 	FS::PathString contentSaveDirectory_;
 	FS::PathString userSaveDirectory_;
@@ -37,6 +37,7 @@ public:
 	MutablePixmapView pixmap() const;
 	explicit operator bool() const;
 	void endFrame();
+	void cancelFrame();
 
 protected:
 	EmuSystemTaskContext taskCtx;
@@ -0,0 +1,105 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/time/Time.hh>
+
+namespace IG
+{
+class FileIO;
+}
+#endif
+#ifndef IG_USE_MODULE_STD
+#include <array>
+#include <atomic>
+#include <vector>
+#include <string_view>
+#endif
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+enum class FrameTraceEvent : uint8_t
+{
+	input,
+	runFrameStart,
+	runFrameEnd,
+	videoFrameFinished,
+	present,
+	audioWrite,
+};
+
+std::string_view asString(FrameTraceEvent);
+
+struct FrameTraceRecord
+{
+	SteadyClockTimePoint time{};
+	uint32_t frame{};
+	FrameTraceEvent event{};
+};
+
+// Records timestamped frame events from any thread into a fixed-size ring when enabled,
+// the oldest records are overwritten and a disabled trace only costs an atomic load per event
+class FrameTrace
+{
+public:
+	static constexpr size_t capacity = 4096;
+
+	void setEnabled(bool on)
+	{
+		// each recording starts without the events of earlier ones
+		if(on && !isEnabled())
+			clear();
+		enabled.store(on, std::memory_order_relaxed);
+	}
+	bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+	void nextFrame() { frame.store(frame.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+	void record(FrameTraceEvent event, SteadyClockTimePoint time = {})
+	{
+		if(!isEnabled())
+			return;
+		recordAlways(event, time);
+	}
+
+	void clear();
+	std::vector<FrameTraceRecord> records() const;
+	void writeChromeTrace(FileIO &) const;
+	void writeCSV(FileIO &) const;
+
+private:
+	// each field is atomic so readers never see torn values, seq is stored last with
+	// the record index + 1 to detect a slot that's being overwritten during a read
+	struct Slot
+	{
+		std::atomic_int64_t timeNs;
+		std::atomic_uint32_t frame;
+		std::atomic_uint8_t event;
+		std::atomic_size_t seq;
+	};
+
+	std::array<Slot, capacity> slots{};
+	std::atomic_size_t writeIdx{};
+	std::atomic_uint32_t frame{};
+	std::atomic_bool enabled{};
+
+	void recordAlways(FrameTraceEvent, SteadyClockTimePoint);
+};
+
+}
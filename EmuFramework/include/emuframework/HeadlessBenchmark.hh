@@ -0,0 +1,47 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/base/BaseApplication.hh>
+#endif
+#ifndef IG_USE_MODULE_STD
+#include <optional>
+#endif
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+
+// Runs content without any windows or UI when the app is started as:
+// <app> --benchmark <content path> [--frames=N] [--audio] [--jobs[=N]]
+// and prints the frames per second, per-frame p50/p99 time, and peak RSS
+struct HeadlessBenchmarkParams
+{
+	const char *contentPath{};
+	int frames{1800};
+	// number of processes to run in parallel, 0 uses one per CPU
+	int jobs{1};
+	bool audio{};
+};
+
+std::optional<HeadlessBenchmarkParams> parseHeadlessBenchmarkArgs(CommandArgs);
+int runHeadlessBenchmark(EmuApp &, HeadlessBenchmarkParams, CommandArgs);
+
+}
@@ -31,6 +31,7 @@ import std;
 #include <string_view>
 #include <memory>
 #include <algorithm>
+#include <atomic>
 #endif
 
 namespace EmuEx
@@ -48,13 +49,15 @@ public:
 	TurboInput turboActions;
 	ToggleInput toggleInput;
 	DelegateFunc<void ()> onUpdateDevices;
-	bool turboModifierActive{};
+	// also read by handleQueuedKeyEvent() on the emulation thread
+	std::atomic_bool turboModifierActive{};
 
 	InputManager(ApplicationContext ctx):
 		vController{ctx} {}
 	bool handleKeyInput(EmuApp&, KeyInfo, const Input::Event& srcEvent);
 	bool handleAppActionKeyInput(EmuApp&, InputAction, const Input::Event& srcEvent);
 	void handleSystemKeyInput(EmuApp&, KeyInfo, Input::Action, uint32_t metaState = 0, SystemKeyInputFlags = {});
+	bool handleQueuedKeyEvent(EmuApp&, const Input::KeyEvent&);
 	void updateInputDevices(ApplicationContext);
 	KeyConfig* customKeyConfig(std::string_view name, const Input::Device&) const;
 	KeyConfigDesc keyConfig(std::string_view name, const Input::Device&) const;
@@ -19,6 +19,8 @@
 #ifndef IG_USE_MODULE_IMAGINE
 #include <imagine/base/PausableTimer.hh>
 #include <imagine/util/memory/FlexArray.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <imagine/thread/Semaphore.hh>
 
 namespace IG
 {
@@ -26,6 +28,11 @@ class MapIO;
 class FileIO;
 }
 #endif
+#ifndef IG_USE_MODULE_STD
+#include <vector>
+#include <thread>
+#include <atomic>
+#endif
 
 namespace EmuEx
 {
@@ -33,11 +40,20 @@ namespace EmuEx
 using namespace IG;
 
 class EmuApp;
+class EmuSystem;
+
+enum class RewindStorageMode : uint8_t
+{
+	Full, Delta
+};
+
+inline constexpr int8_t maxRewindFrameInterval = 60;
 
 class RewindManager
 {
 public:
 	RewindManager(EmuApp &);
+	~RewindManager();
 	void clear();
 	bool reset();
 	void rewindState(EmuApp &);
@@ -46,6 +62,14 @@ public:
 	void resetTimer();
 	bool readConfig(MapIO &, unsigned key);
 	void writeConfig(FileIO &) const;
+	void setStorageMode(RewindStorageMode);
+	RewindStorageMode storageMode() const { return storageMode_; }
+	void setFrameInterval(int8_t);
+	int8_t frameInterval() const { return frameInterval_; }
+	void setRewinding(bool on) { rewinding.store(on, std::memory_order::relaxed); }
+	// called on the emulation thread when using frame based capture
+	void captureFrames(EmuSystem &, int frames);
+	bool rewindFrame(EmuApp &);
 
 	void updateMaxStates(size_t max)
 	{
@@ -66,15 +90,44 @@ private:
 		uint8_t data[];
 	};
 
+	// Full mode, each entry holds a complete state
 	FlexArray<StateEntry> stateEntries;
+	// Delta mode, the newest state is kept whole as a keyframe and each entry holds
+	// an XOR/RLE encoded delta that reconstructs the state saved before it
+	std::vector<std::vector<uint8_t>> deltaEntries;
+	DynArray<uint8_t> keyState;
+	DynArray<uint8_t> scratchState;
+	size_t keyStateSize{};
+	size_t deltaCount{};
 	size_t stateIdx{};
+	// Frame based capture, the emulation thread writes states into one of two
+	// buffers and a worker thread commits them into the above storage
+	DynArray<uint8_t> captureBuffers[2];
+	size_t captureSizes[2]{};
+	std::thread captureThread;
+	// one release per pending capture plus one to signal quit
+	counting_semaphore<3> captureSem{0};
+	std::atomic_int8_t pendingCaptures{};
+	std::atomic_bool rewinding{};
+	bool quitCaptureThread{};
+	uint8_t captureWriteIdx{};
+	uint8_t captureReadIdx{};
+	int8_t frameInterval_{};
+	int8_t framesUntilCapture{};
+	RewindStorageMode storageMode_{RewindStorageMode::Delta};
 public:
 	size_t stateSize{};
 	size_t maxStates{};
 	PausableTimer<Seconds> saveTimer;
 
 private:
+	bool hasStorage() const;
 	void saveState(EmuApp &);
+	void commitState(DynArray<uint8_t> &, size_t size);
+	bool loadNewestState(bool keepOldest, auto &&readState);
+	void startCaptureThread();
+	void stopCaptureThread();
+	void waitForCaptures();
 };
 
 }
@@ -0,0 +1,91 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/defs.hh>
+#include <emuframework/EmuSystemTaskContext.hh>
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/util/memory/DynArray.hh>
+
+namespace IG
+{
+class MapIO;
+class FileIO;
+}
+#endif
+#ifndef IG_USE_MODULE_STD
+#include <array>
+#include <atomic>
+#endif
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+class EmuSystem;
+class EmuVideo;
+class EmuAudio;
+
+inline constexpr int8_t maxRunAheadFrames = 4;
+
+enum class RunAheadMode : uint8_t
+{
+	// run ahead every frame and restore the real state afterwards
+	Full,
+	// keep snapshots of the last frames and only roll back when input changes
+	Preemptive,
+};
+
+// Emulates frames ahead of the real system state and presents the last one to hide
+// the system's internal input lag, the real state is restored from memory afterwards
+class RunAheadManager
+{
+public:
+	void clear();
+	bool reset(size_t stateSize);
+	void setFrames(int8_t);
+	int8_t frames() const { return frames_; }
+	void setMode(RunAheadMode);
+	RunAheadMode mode() const { return mode_; }
+	void invalidateSnapshots();
+	void onInputChanged() { inputChanged.store(true, std::memory_order_relaxed); }
+	void runFrames(EmuSystemTaskContext, EmuApp &, EmuVideo *, EmuAudio *, int frames);
+	bool readConfig(MapIO &, unsigned key);
+	void writeConfig(FileIO &) const;
+
+private:
+	std::array<DynArray<uint8_t>, maxRunAheadFrames> snapshots;
+	std::array<size_t, maxRunAheadFrames> snapshotSizes{};
+	size_t stateSize{};
+	int8_t frames_{};
+	RunAheadMode mode_{};
+	bool snapshotIsPrimed{};
+	// ring of states taken before each of the last frames_ emulated frames
+	int8_t ringHead{};
+	int8_t ringCount{};
+	std::atomic_bool inputChanged{};
+
+	bool allocSnapshots();
+	int8_t snapshotCount() const { return mode_ == RunAheadMode::Preemptive ? frames_ : 1; }
+	void runFramesAhead(EmuSystemTaskContext, EmuApp &, EmuVideo *, EmuAudio *, int frames);
+	void runFramesPreemptive(EmuSystemTaskContext, EmuApp &, EmuVideo *, EmuAudio *, int frames);
+	void pushSnapshot(EmuSystem &);
+	bool rollback(EmuSystemTaskContext, EmuApp &);
+};
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/inputDefs.hh>
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/time/Time.hh>
+#include <imagine/util/container/ArrayList.hh>
+#endif
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+
+// Applies game input from the input thread at the point in the emulated frame it arrived instead
+// of only between frames. While a frame runs, actions are queued with their event times and cores
+// call poll() where the game reads its controllers, passing how far through the frame emulation is.
+// Emulated time is mapped to the wall clock starting from when the frame began running, so input
+// that arrives while the frame is emulating can still be seen by the game in the same frame, and
+// anything older is applied at the first poll.
+class SubFrameInput
+{
+public:
+	void beginFrame(EmuApp &, SteadyClockTimePoint startTime, SteadyClockDuration frameDuration);
+	void endFrame(EmuApp &);
+	bool queue(InputAction, SteadyClockTimePoint time);
+	bool isActive() const { return appPtr; }
+	// actions left from a previous frame must go through the queue to keep their order
+	bool hasQueuedActions() const { return actions.size(); }
+	void clear();
+
+	// framePos is the fraction of the frame emulated so far, returns true if any input was applied
+	bool poll(float framePos)
+	{
+		if(!appPtr)
+			return false;
+		return applyQueued(framePos);
+	}
+
+private:
+	struct QueuedAction
+	{
+		InputAction action;
+		SteadyClockTimePoint time;
+	};
+
+	EmuApp *appPtr{};
+	SteadyClockTimePoint frameStartTime{};
+	SteadyClockDuration frameDuration{};
+	StaticArrayList<QueuedAction, 32> actions;
+	size_t appliedActions{};
+
+	bool applyQueued(float framePos);
+	bool applyUntil(EmuApp &, SteadyClockTimePoint);
+};
+
+}
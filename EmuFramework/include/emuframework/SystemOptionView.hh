@@ -16,6 +16,7 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <emuframework/EmuAppHelper.hh>
+#include <emuframework/RunAheadManager.hh>
 #ifndef IG_USE_MODULE_IMAGINE
 #include <imagine/gui/TableView.hh>
 #include <imagine/gui/MenuItem.hh>
@@ -44,16 +45,23 @@ protected:
 	MultiChoiceMenuItem fastModeSpeed;
 	TextMenuItem slowModeSpeedItem[3];
 	MultiChoiceMenuItem slowModeSpeed;
+	TextMenuItem runAheadFramesItem[maxRunAheadFrames + 1];
+	MultiChoiceMenuItem runAheadFrames;
+	BoolMenuItem runAheadMode;
+	TextMenuItem archiveCacheSizeItem[5];
+	MultiChoiceMenuItem archiveCacheSize;
 	TextMenuItem rewindStatesItem[4];
 	MultiChoiceMenuItem rewindStates;
 	DualTextMenuItem rewindTimeInterval;
+	DualTextMenuItem rewindFrameInterval;
+	BoolMenuItem rewindStorageMode;
 	ConditionalMember<Config::envIsAndroid, BoolMenuItem> performanceMode;
 	ConditionalMember<Config::envIsAndroid && Config::DEBUG_BUILD, BoolMenuItem> noopThread;
 	ConditionalMember<Config::cpuAffinity, TextMenuItem> cpuAffinity;
 	TextHeadingMenuItem autosaveHeading;
 	TextHeadingMenuItem rewindHeading;
 	TextHeadingMenuItem otherHeading;
-	StaticArrayList<MenuItem*, 33> item;
+	StaticArrayList<MenuItem*, 35> item;
 };
 
 }
@@ -31,6 +31,7 @@
 #include <vector>
 #include <span>
 #include <optional>
+#include <atomic>
 #endif
 
 #ifndef IG_USE_MODULE_IMAGINE
@@ -668,7 +669,8 @@ private:
 	bool physicalControlsPresent{};
 	bool gamepadIsVisible{gamepadControlsVisibility_ != VControllerVisibility::OFF};
 	VControllerGamepadFlags gamepadDisabledFlags{};
-	bool kbMode{};
+	// also read by InputManager::handleQueuedKeyEvent() on the emulation thread
+	std::atomic_bool kbMode{};
 	uint8_t alpha{};
 	ConditionalMember<Config::DISPLAY_CUTOUT, bool> allowButtonsPastContentBounds_{};
 	ConditionalMember<Config::BASE_SUPPORTS_VIBRATOR, bool> vibrateOnTouchInput_{};
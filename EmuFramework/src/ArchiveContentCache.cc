@@ -0,0 +1,332 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/ArchiveContentCache.hh>
+#include <emuframework/EmuOptions.hh>
+#include <emuframework/Option.hh>
+#include <sys/stat.h>
+#include <fcntl.h>
+import imagine;
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+constexpr SystemLogger log{"ArchiveCache"};
+constexpr std::string_view cacheDirName{"ArchiveContent"};
+constexpr std::string_view manifestName{".manifest"};
+// written next to a key's directory when the archive's contents exceed the size limit
+constexpr std::string_view tooLargeSuffix{".tooLarge"};
+constexpr size_t copyBuffSize = 0x40000;
+
+static FS::FileString cacheKey(std::string_view archivePath, WallClockTimePoint lastWriteTime)
+{
+	// FNV-1a over the path and write time so the key stays stable across app versions
+	uint64_t hash = 0xcbf29ce484222325;
+	auto hashBytes = [&](const void *data, size_t size)
+	{
+		for(auto b : std::span{static_cast<const uint8_t*>(data), size})
+		{
+			hash = (hash ^ b) * 0x100000001b3;
+		}
+	};
+	hashBytes(archivePath.data(), archivePath.size());
+	auto timeCount = int64_t(lastWriteTime.time_since_epoch().count());
+	hashBytes(&timeCount, sizeof(timeCount));
+	return FS::FileString{std::format("{:016x}", hash)};
+}
+
+static std::vector<FS::PathString> subDirectories(CStringView path)
+{
+	std::vector<FS::PathString> dirs;
+	FS::forEachInDirectory(path, [&](auto &entry)
+	{
+		if(entry.type() == FS::file_type::directory)
+			dirs.emplace_back(entry.path());
+		return true;
+	}, {.test = true});
+	return dirs;
+}
+
+static void removeDirectory(CStringView path)
+{
+	// cache directories are flat since entries are stored by their base name
+	std::vector<FS::PathString> files;
+	FS::forEachInDirectory(path, [&](auto &entry)
+	{
+		files.emplace_back(entry.path());
+		return true;
+	}, {.test = true});
+	for(const auto &f : files)
+	{
+		FS::remove(f);
+	}
+	FS::remove(path);
+}
+
+static ArchiveContentCache::Content readManifest(CStringView dir)
+{
+	auto buff = FileUtils::bufferFromPath(FS::pathString(dir, manifestName), {.test = true});
+	if(!buff)
+		return {};
+	ArchiveContentCache::Content content{.directory{dir}};
+	for(auto line : std::views::split(buff.stringView(), '\n'))
+	{
+		std::string_view lineStr{line.begin(), line.end()};
+		if(lineStr.empty())
+			continue;
+		// line format: <crc32 hex> <size> <name>
+		ArchiveContentCache::Entry entry;
+		auto crcEnd = std::from_chars(lineStr.data(), lineStr.data() + lineStr.size(), entry.crc32, 16).ptr;
+		if(crcEnd == lineStr.data() + lineStr.size() || *crcEnd != ' ')
+			return {};
+		auto sizeEnd = std::from_chars(crcEnd + 1, lineStr.data() + lineStr.size(), entry.size).ptr;
+		if(sizeEnd == lineStr.data() + lineStr.size() || *sizeEnd != ' ')
+			return {};
+		entry.name = std::string_view{sizeEnd + 1, lineStr.data() + lineStr.size()};
+		// catch files removed or truncated outside the app
+		if(FS::file_size(content.filePath(entry.name)) != entry.size)
+		{
+			log.warn("cached file:{} doesn't match manifest", entry.name);
+			return {};
+		}
+		content.entries.emplace_back(entry);
+	}
+	if(content.entries.empty())
+		return {};
+	return content;
+}
+
+static bool writeManifest(CStringView dir, const ArchiveContentCache::Content &content)
+{
+	std::string manifest;
+	for(const auto &e : content.entries)
+	{
+		std::format_to(std::back_inserter(manifest), "{:08x} {} {}\n", e.crc32, e.size, e.name);
+	}
+	// write to a temporary file first so a partial manifest is never seen as a valid entry
+	auto tempPath = FS::pathString(dir, ".manifest.tmp");
+	if(FileUtils::writeToPath(tempPath, std::span{reinterpret_cast<const unsigned char*>(manifest.data()), manifest.size()})
+		!= ssize_t(manifest.size()))
+	{
+		FS::remove(tempPath);
+		return false;
+	}
+	return FS::rename(tempPath, FS::pathString(dir, manifestName));
+}
+
+static FS::PathString tooLargeMarkerPath(CStringView dir)
+{
+	FS::PathString path{dir};
+	path += tooLargeSuffix;
+	return path;
+}
+
+// returns the size limit in bytes that was exceeded when the marker was written
+static size_t tooLargeMarkerLimit(CStringView dir)
+{
+	auto buff = FileUtils::bufferFromPath(tooLargeMarkerPath(dir), {.test = true});
+	if(!buff)
+		return 0;
+	auto str = buff.stringView();
+	size_t limit{};
+	std::from_chars(str.data(), str.data() + str.size(), limit);
+	return limit;
+}
+
+static void touch(CStringView path)
+{
+	// the manifest's write time tracks the last use of its directory for eviction
+	::utimensat(AT_FDCWD, path, nullptr, 0);
+}
+
+FS::PathString ArchiveContentCache::Content::filePath(std::string_view name) const
+{
+	return FS::pathString(directory, name);
+}
+
+ArchiveContentCache::Content ArchiveContentCache::content(ApplicationContext ctx, CStringView archivePath)
+{
+	if(!isEnabled())
+		return {};
+	auto cachePath = FS::pathString(ctx.cachePath(), cacheDirName);
+	auto key = cacheKey(archivePath, ctx.fileUriLastWriteTime(archivePath));
+	auto dir = FS::pathString(cachePath, key);
+	if(auto content = readManifest(dir); content)
+	{
+		log.info("using cached content of:{} in:{}", archivePath, dir);
+		touch(FS::pathString(dir, manifestName));
+		return content;
+	}
+	if(tooLargeMarkerLimit(dir) >= maxBytes())
+	{
+		log.info("contents of:{} previously exceeded cache size limit", archivePath);
+		return {};
+	}
+	try
+	{
+		FS::create_directory(cachePath);
+		auto content = extract(ctx, archivePath, dir);
+		if(content)
+			evict(cachePath, key);
+		return content;
+	}
+	catch(std::exception &err)
+	{
+		log.error("error caching:{} ({})", archivePath, err.what());
+		removeDirectory(dir);
+		return {};
+	}
+}
+
+ArchiveContentCache::Content ArchiveContentCache::extract(ApplicationContext ctx, CStringView archivePath, CStringView dir)
+{
+	auto archive = ctx.openFileUri(archivePath, {.test = true, .accessHint = IOAccessHint::Sequential});
+	if(!archive || archive.size() < minArchiveBytes)
+		return {};
+	// clear any entries left from an interrupted extraction
+	removeDirectory(dir);
+	FS::create_directory(dir);
+	log.info("extracting:{} to:{}", archivePath, dir);
+	Content content{.directory{dir}};
+	auto buff = std::make_unique_for_overwrite<uint8_t[]>(copyBuffSize);
+	size_t totalSize{};
+	auto skipTooLarge = [&]() -> Content
+	{
+		log.info("archive contents exceed cache size limit");
+		removeDirectory(dir);
+		// later launches skip extraction until the archive changes or the limit is raised
+		auto limitStr = std::format("{}", maxBytes());
+		FileUtils::writeToPath(tooLargeMarkerPath(dir),
+			std::span{reinterpret_cast<const unsigned char*>(limitStr.data()), limitStr.size()});
+		return {};
+	};
+	for(auto &entry : FS::ArchiveIterator{std::move(archive)})
+	{
+		if(entry.type() == FS::file_type::directory)
+			continue;
+		auto name = FS::basename(entry.name());
+		if(std::ranges::any_of(content.entries, [&](auto &e){ return e.name == name; }))
+		{
+			log.warn("skipping duplicate entry name:{}", entry.name());
+			continue;
+		}
+		// stop before writing an entry whose size in the header already exceeds the limit
+		if(totalSize + entry.size() > maxBytes())
+			return skipTooLarge();
+		FileIO file{content.filePath(name), OpenFlags::newFile()};
+		// read to the end of the entry since some formats don't store the size up front
+		size_t size{};
+		while(true)
+		{
+			auto bytesRead = entry.read(buff.get(), copyBuffSize);
+			if(bytesRead == -1)
+				throw std::runtime_error(std::format("error reading entry:{}", entry.name()));
+			if(!bytesRead)
+				break;
+			size += bytesRead;
+			if(totalSize + size > maxBytes())
+				return skipTooLarge();
+			if(file.write(buff.get(), bytesRead) != bytesRead)
+				throw std::runtime_error(std::format("error writing entry:{}", name));
+		}
+		totalSize += size;
+		content.entries.emplace_back(name, size, entry.crc32());
+	}
+	if(content.entries.empty() || !writeManifest(dir, content))
+	{
+		removeDirectory(dir);
+		return {};
+	}
+	return content;
+}
+
+void ArchiveContentCache::evict(CStringView cachePath, std::string_view keepDir)
+{
+	struct DirInfo
+	{
+		FS::PathString path;
+		FS::file_time_type lastUsed;
+		size_t size;
+	};
+	std::vector<DirInfo> dirs;
+	size_t totalSize{};
+	for(const auto &path : subDirectories(cachePath))
+	{
+		bool isKeepDir = FS::basename(path) == keepDir;
+		auto content = readManifest(path);
+		if(!content)
+		{
+			// partial extraction from a previous crash
+			if(!isKeepDir)
+				removeDirectory(path);
+			continue;
+		}
+		size_t size{};
+		for(const auto &e : content.entries)
+		{
+			size += e.size;
+		}
+		totalSize += size;
+		if(!isKeepDir)
+			dirs.emplace_back(path, FS::status(FS::pathString(path, manifestName)).lastWriteTime(), size);
+	}
+	std::ranges::sort(dirs, {}, &DirInfo::lastUsed);
+	for(const auto &d : dirs)
+	{
+		if(totalSize <= maxBytes())
+			break;
+		log.info("evicting:{}", d.path);
+		removeDirectory(d.path);
+		totalSize -= d.size;
+	}
+}
+
+void ArchiveContentCache::clear(ApplicationContext ctx)
+{
+	auto cachePath = FS::pathString(ctx.cachePath(), cacheDirName);
+	for(const auto &path : subDirectories(cachePath))
+	{
+		removeDirectory(path);
+	}
+	std::vector<FS::PathString> markers;
+	FS::forEachInDirectory(cachePath, [&](auto &entry)
+	{
+		if(entry.name().ends_with(tooLargeSuffix))
+			markers.emplace_back(entry.path());
+		return true;
+	}, {.test = true});
+	for(const auto &m : markers)
+	{
+		FS::remove(m);
+	}
+}
+
+bool ArchiveContentCache::readConfig(MapIO &io, unsigned key)
+{
+	switch(key)
+	{
+		default: return false;
+		case CFGKEY_ARCHIVE_CACHE_SIZE: return readOptionValue(io, maxMiB_);
+	}
+}
+
+void ArchiveContentCache::writeConfig(FileIO &io) const
+{
+	writeOptionValueIfNotDefault(io, CFGKEY_ARCHIVE_CACHE_SIZE, maxMiB_, defaultMaxMiB);
+}
+
+}
@@ -0,0 +1,78 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/AudioResampler.hh>
+#define RANDOM_PREFIX EmuEx
+#include "shared/mednafen/resampler/resampler.h"
+import imagine;
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"AudioResampler"};
+
+// ratios are passed to the resampler as fractions over this value
+constexpr uint32_t ratioScale = 20000;
+
+AudioResampler::AudioResampler(Audio::Format format, int quality):
+	sampleFormat{format.sample}
+{
+	int err{};
+	state.reset(speex_resampler_init_frac(format.channels, ratioScale, ratioScale, format.rate, format.rate, quality, &err));
+	if(!state)
+	{
+		log.error("error:{} creating resampler", speex_resampler_strerror(err));
+		return;
+	}
+	speex_resampler_skip_zeros(state.get());
+}
+
+void AudioResampler::StateDeleter::operator()(SpeexResamplerState_ *ptr) const
+{
+	speex_resampler_destroy(ptr);
+}
+
+void AudioResampler::setRatio(double inputFramesPerOutputFrame)
+{
+	if(ratio_ == inputFramesPerOutputFrame)
+		return;
+	ratio_ = inputFramesPerOutputFrame;
+	uint32_t num = std::max(std::round(inputFramesPerOutputFrame * ratioScale), 1.);
+	uint32_t inRate, outRate;
+	speex_resampler_get_rate(state.get(), &inRate, &outRate);
+	speex_resampler_set_rate_frac(state.get(), num, ratioScale, inRate, outRate);
+}
+
+size_t AudioResampler::process(void *dest, size_t destFrames, const void *src, size_t srcFrames)
+{
+	assume(state);
+	spx_uint32_t inLen = srcFrames;
+	spx_uint32_t outLen = destFrames;
+	if(sampleFormat.isFloat())
+		speex_resampler_process_interleaved_float(state.get(), static_cast<const float*>(src), &inLen, static_cast<float*>(dest), &outLen);
+	else
+		speex_resampler_process_interleaved_int(state.get(), static_cast<const spx_int16_t*>(src), &inLen, static_cast<spx_int16_t*>(dest), &outLen);
+	return outLen;
+}
+
+void AudioResampler::reset()
+{
+	if(!state)
+		return;
+	speex_resampler_reset_mem(state.get());
+	speex_resampler_skip_zeros(state.get());
+}
+
+}
@@ -31,12 +31,6 @@ constexpr bool colorSpaceIsValid(Gfx::ColorSpace val)
 
 void EmuApp::saveConfigFile(FileIO &io)
 {
-	if(!io)
-	{
-		log.info("not writing config file");
-		return;
-	}
-	writeConfigHeader(io);
 	recentContent.writeConfig(io);
 	if(!AppMeta::handlesRecentContent)
 	{
@@ -77,6 +71,8 @@ void EmuApp::saveConfigFile(FileIO &io)
 	writeOptionValueIfNotDefault(io, useSustainedPerformanceMode);
 	writeOptionValueIfNotDefault(io, keepBluetoothActive);
 	writeOptionValueIfNotDefault(io, notifyOnInputDeviceChange);
+	if(appContext().hasInputThread())
+		writeOptionValue(io, CFGKEY_INPUT_THREAD, true);
 	if(appContext().hasTranslucentSysUI() && !doesLayoutBehindSystemUI())
 		writeOptionValue(io, CFGKEY_LAYOUT_BEHIND_SYSTEM_UI, false);
 	writeOptionValueIfNotDefault(io, contentRotation);
@@ -91,6 +87,8 @@ void EmuApp::saveConfigFile(FileIO &io)
 	inputManager.vController.writeConfig(io);
 	autosaveManager.writeConfig(io);
 	rewindManager.writeConfig(io);
+	runAheadManager.writeConfig(io);
+	archiveContentCache.writeConfig(io);
 	audio.writeConfig(io);
 	videoLayer.writeConfig(io);
 	if(overrideScreenFrameRate)
@@ -160,6 +158,10 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(ApplicationContext ctx)
 						return true;
 					if(rewindManager.readConfig(io, key))
 						return true;
+					if(runAheadManager.readConfig(io, key))
+						return true;
+					if(archiveContentCache.readConfig(io, key))
+						return true;
 					if(audio.readConfig(io, key))
 						return true;
 					if(recentContent.readConfig(io, key))
@@ -201,6 +203,8 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(ApplicationContext ctx)
 				case CFGKEY_NOTIFY_INPUT_DEVICE_CHANGE: return readOptionValue(io, notifyOnInputDeviceChange);
 				case CFGKEY_MOGA_INPUT_SYSTEM:
 					return MOGA_INPUT ? readOptionValue<bool>(io, [&](auto on){setMogaManagerActive(on, false);}) : false;
+				case CFGKEY_INPUT_THREAD:
+					return readOptionValue<bool>(io, [&](auto on){ appContext().setInputThread(on); });
 				case CFGKEY_TEXTURE_BUFFER_MODE: return readOptionValue(io, textureBufferMode);
 				case CFGKEY_LOW_PROFILE_OS_NAV: return readOptionValue(io, lowProfileOSNav);
 				case CFGKEY_HIDE_OS_NAV: return readOptionValue(io, hidesOSNav);
@@ -256,8 +260,8 @@ void EmuApp::saveConfigFile(ApplicationContext ctx)
 	auto configFilePath = FS::pathString(ctx.supportPath(), "config");
 	try
 	{
-		FileIO file{configFilePath, OpenFlags::newFile()};
-		saveConfigFile(file);
+		if(writeConfigFile(configFilePath, [&](FileIO &file){ saveConfigFile(file); }) == ConfigWriteResult::unchanged)
+			log.info("config file unchanged");
 	}
 	catch(...)
 	{
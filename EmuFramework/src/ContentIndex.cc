@@ -0,0 +1,203 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/ContentIndex.hh>
+import imagine;
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+constexpr SystemLogger log{"ContentIndex"};
+constexpr std::string_view indexFileName{"ContentIndex"};
+constexpr uint32_t indexMagic = 0x58444943; // "CIDX"
+constexpr uint32_t indexVersion = 1;
+// entries added within the file system's timestamp resolution may not change the directory's write time
+constexpr auto minDirectoryAge = Seconds{2};
+
+static FS::PathString indexPath(ApplicationContext ctx)
+{
+	return FS::pathString(ctx.cachePath(), indexFileName);
+}
+
+bool ContentIndex::Directory::forEachEntry(DirectoryEntryDelegate del) const
+{
+	for(const auto &e : entries)
+	{
+		auto data = std::string_view{entryData}.substr(e.dataOffset);
+		FS::PathString entryPath{std::string_view{path}.substr(0, e.pathPrefixSize)};
+		entryPath += data.substr(0, e.pathSuffixSize);
+		if(!del(FS::directory_entry{entryPath, data.substr(e.pathSuffixSize, e.nameSize), e.type}))
+			return false;
+	}
+	return true;
+}
+
+void ContentIndex::forEachInDirectory(ApplicationContext ctx, CStringView path, DirectoryEntryDelegate del)
+{
+	auto lastWriteTime = ctx.fileUriLastWriteTime(path);
+	{
+		std::scoped_lock lock{mutex};
+		if(!isLoaded)
+			load(ctx);
+		if(auto it = std::ranges::find(dirs, std::string_view{path}, &Directory::path);
+			it != dirs.end())
+		{
+			if(hasTime(lastWriteTime) && it->lastWriteTime == lastWriteTime)
+			{
+				// only the order changes so this alone doesn't need the index saved again
+				std::rotate(it, it + 1, dirs.end());
+				dirs.back().forEachEntry(del);
+				return;
+			}
+			log.info("directory:{} changed since indexed", path);
+			dirs.erase(it);
+			isDirty = true;
+		}
+	}
+	Directory dir{.path{path}, .lastWriteTime = lastWriteTime};
+	if(!index(dir, ctx, del) || !hasTime(lastWriteTime) || WallClock::now() - lastWriteTime < minDirectoryAge)
+		return;
+	std::scoped_lock lock{mutex};
+	std::erase_if(dirs, [&](const auto &d){ return d.path == dir.path; });
+	if(dirs.size() >= maxDirectories)
+		dirs.erase(dirs.begin());
+	dirs.emplace_back(std::move(dir));
+	isDirty = true;
+}
+
+bool ContentIndex::index(Directory &dir, ApplicationContext ctx, DirectoryEntryDelegate del)
+{
+	bool completed = true;
+	ctx.forEachInDirectoryUri(dir.path, [&](const FS::directory_entry &entry)
+	{
+		if(!del(entry))
+		{
+			completed = false;
+			return false;
+		}
+		std::string_view entryPath{entry.path()};
+		auto name = entry.name();
+		// entry paths usually start with the directory's path or URI, so only the rest is stored
+		auto prefixSize = std::ranges::mismatch(entryPath, dir.path).in1 - entryPath.begin();
+		dir.entries.emplace_back(uint32_t(dir.entryData.size()), uint16_t(prefixSize),
+			uint16_t(entryPath.size() - prefixSize), uint16_t(name.size()), entry.type());
+		dir.entryData.append(entryPath.substr(prefixSize)).append(name);
+		return true;
+	});
+	return completed;
+}
+
+void ContentIndex::load(ApplicationContext ctx)
+{
+	isLoaded = true;
+	MapIO io{FileUtils::bufferFromPath(indexPath(ctx), {.test = true})};
+	if(!io)
+		return;
+	auto bytesLeft = [&]{ return size_t(io.size() - io.tell()); };
+	if(bytesLeft() < 12 || io.get<uint32_t>() != indexMagic || io.get<uint32_t>() != indexVersion)
+	{
+		log.info("ignoring index with unknown format");
+		return;
+	}
+	auto dirCount = std::min(io.get<uint32_t>(), uint32_t(maxDirectories));
+	std::vector<Directory> loadedDirs;
+	loadedDirs.reserve(dirCount);
+	auto readDirectory = [&](Directory &d)
+	{
+		if(bytesLeft() < 2)
+			return false;
+		auto pathSize = io.get<uint16_t>();
+		if(bytesLeft() < pathSize + 16u || io.readSized(d.path, pathSize) != pathSize)
+			return false;
+		d.lastWriteTime = WallClockTimePoint{WallClockTimePoint::duration{io.get<int64_t>()}};
+		auto entryCount = io.get<uint32_t>();
+		auto dataSize = io.get<uint32_t>();
+		if(bytesLeft() < size_t(entryCount) * 7 + dataSize)
+			return false;
+		d.entries.reserve(entryCount);
+		uint32_t dataOffset{};
+		for(auto _ : iotaCount(entryCount))
+		{
+			Entry e{.dataOffset = dataOffset};
+			e.pathPrefixSize = io.get<uint16_t>();
+			e.pathSuffixSize = io.get<uint16_t>();
+			e.nameSize = io.get<uint16_t>();
+			e.type = FS::file_type(io.get<uint8_t>());
+			if(e.pathPrefixSize > pathSize)
+				return false;
+			dataOffset += e.pathSuffixSize + e.nameSize;
+			d.entries.emplace_back(e);
+		}
+		return dataOffset == dataSize && io.readSized(d.entryData, dataSize) == dataSize;
+	};
+	for(auto _ : iotaCount(dirCount))
+	{
+		if(!readDirectory(loadedDirs.emplace_back()))
+		{
+			log.error("ignoring corrupt index");
+			return;
+		}
+	}
+	dirs = std::move(loadedDirs);
+	log.info("loaded index of {} directories", dirs.size());
+}
+
+void ContentIndex::save(ApplicationContext ctx)
+{
+	std::scoped_lock lock{mutex};
+	if(!isDirty)
+		return;
+	auto path = indexPath(ctx);
+	auto tempPath = FS::pathString(ctx.cachePath(), "ContentIndex.tmp");
+	try
+	{
+		{
+			FileIO file{tempPath, OpenFlags::newFile()};
+			file.put(indexMagic);
+			file.put(indexVersion);
+			file.put(uint32_t(dirs.size()));
+			for(const auto &d : dirs)
+			{
+				file.put(uint16_t(d.path.size()));
+				file.write(d.path.data(), d.path.size());
+				file.put(int64_t(d.lastWriteTime.time_since_epoch().count()));
+				file.put(uint32_t(d.entries.size()));
+				file.put(uint32_t(d.entryData.size()));
+				for(const auto &e : d.entries)
+				{
+					file.put(e.pathPrefixSize);
+					file.put(e.pathSuffixSize);
+					file.put(e.nameSize);
+					file.put(uint8_t(e.type));
+				}
+				if(file.write(d.entryData.data(), d.entryData.size()) != ssize_t(d.entryData.size()))
+					throw std::runtime_error("write failed");
+			}
+		}
+		if(!FS::rename(tempPath, path))
+			throw std::runtime_error("can't replace previous index");
+		isDirty = false;
+		log.info("saved index of {} directories", dirs.size());
+	}
+	catch(std::exception &err)
+	{
+		log.error("error writing:{} ({})", path, err.what());
+		FS::remove(tempPath);
+	}
+}
+
+}
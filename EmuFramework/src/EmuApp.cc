@@ -24,6 +24,7 @@
 #include <emuframework/FilePathOptionView.hh>
 #include <emuframework/FilePicker.hh>
 #include <emuframework/Option.hh>
+#include <emuframework/HeadlessBenchmark.hh>
 #include "gui/AutosaveSlotView.hh"
 #include "WindowData.hh"
 #include "InputDeviceData.hh"
@@ -44,7 +45,7 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 	Application{initParams},
 	fontManager{ctx},
 	renderer{ctx},
-	audio{ctx},
+	audio{ctx, frameTrace},
 	videoLayer{video, defaultVideoAspectRatio()},
 	inputManager{ctx},
 	assetManager{ctx},
@@ -55,7 +56,8 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 	perfHintManager{ctx.performanceHintManager()},
 	layoutBehindSystemUI{ctx.hasTranslucentSysUI()}
 {
-	if(ctx.registerInstance(initParams))
+	// benchmark jobs run as separate processes so they can't be forwarded to a running instance
+	if(!parseHeadlessBenchmarkArgs(initParams.commandArgs()) && ctx.registerInstance(initParams))
 	{
 		ctx.exit();
 		return;
@@ -145,6 +147,7 @@ void EmuApp::closeSystem()
 	system().closeRuntimeSystem(*this);
 	autosaveManager.resetSlot();
 	rewindManager.clear();
+	runAheadManager.clear();
 	viewController().onSystemClosed();
 }
 
@@ -301,6 +304,11 @@ void EmuApp::mainInitCommon(ApplicationInitParams initParams, ApplicationContext
 	system().onOptionsLoaded();
 	loadSystemOptions();
 	updateLegacySavePathOnStoragePath(ctx, system());
+	if(auto benchmarkParams = parseHeadlessBenchmarkArgs(initParams.commandArgs()))
+	{
+		ctx.exit(runHeadlessBenchmark(*this, *benchmarkParams, initParams.commandArgs()));
+		return;
+	}
 	system().setInitialLoadPath(parseCommandArgs(initParams.commandArgs()));
 	audio.manager.setMusicVolumeControlHint();
 	if(!renderer.supportsColorSpace())
@@ -331,6 +339,7 @@ void EmuApp::mainInitCommon(ApplicationInitParams initParams, ApplicationContext
 			audio.manager.endSession();
 			saveConfigFile(ctx);
 			saveSystemOptions();
+			contentIndex.save(ctx);
 			if(!backgrounded || (backgrounded && !keepBluetoothActive))
 				closeBluetoothConnections();
 			onEvent(ctx, FreeCachesEvent{false});
@@ -461,7 +470,11 @@ void EmuApp::mainInitCommon(ApplicationInitParams initParams, ApplicationContext
 					[&](const Input::DeviceChangeEvent &e)
 					{
 						log.info("got input dev change");
-						inputManager.updateInputDevices(ctx);
+						{
+							// the emulation thread reads device data when handling queued input events
+							auto suspendCtx = suspendEmulationThread();
+							inputManager.updateInputDevices(ctx);
+						}
 						if(notifyOnInputDeviceChange && (e.change == Input::DeviceChange::added || e.change == Input::DeviceChange::removed))
 						{
 							postMessage(2, 0, std::format("{} {}", inputDevData(e.device).displayName, e.change == Input::DeviceChange::added ? "connected" : "disconnected"));
@@ -643,6 +656,9 @@ void EmuApp::showEmulation()
 	resetInput();
 	inputManager.vController.applySavedButtonAlpha();
 	viewController().emuView.setShowFrameTimingStats(showFrameTimingStats);
+	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+	viewController().emuView.setShowAudioStats(true);
+	#endif
 	viewController().showEmulationView();
 	startEmulation();
 }
@@ -731,10 +747,15 @@ void EmuApp::reloadSystem(EmuSystemCreateParams params)
 void EmuApp::onSystemCreated()
 {
 	updateVideoContentRotation();
+	frameTrace.clear();
 	if(!rewindManager.reset(system().stateSize()))
 	{
 		postErrorMessage(4, "Not enough memory for rewind states");
 	}
+	if(!runAheadManager.reset(system().stateSize()))
+	{
+		postErrorMessage(4, "Not enough memory for run-ahead state");
+	}
 	viewController().onSystemCreated();
 }
 
@@ -1083,15 +1104,8 @@ void EmuApp::saveSystemOptions()
 	try
 	{
 		auto configFilePath = FS::pathString(appContext().supportPath(), configName);
-		auto configFile = FileIO{configFilePath, OpenFlags::newFile()};
-		saveSystemOptions(configFile);
-		if(configFile.size() == 1)
-		{
-			// delete file if only header was written
-			configFile = {};
-			FS::remove(configFilePath);
+		if(writeConfigFile(configFilePath, [&](FileIO &file){ saveSystemOptions(file); }) == ConfigWriteResult::removed)
 			log.info("deleted empty system config file");
-		}
 	}
 	catch(...)
 	{
@@ -1101,7 +1115,6 @@ void EmuApp::saveSystemOptions()
 
 void EmuApp::saveSystemOptions(FileIO &configFile)
 {
-	writeConfigHeader(configFile);
 	system().writeConfig(ConfigType::CORE, configFile);
 }
 
@@ -25,37 +25,9 @@ using namespace IG;
 
 constexpr SystemLogger log{"EmuAudio"};
 
-#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-static AudioStats audioStats{};
-static Timer audioStatsTimer{"audioStatsTimer"};
-#endif
-
-static void startAudioStats([[maybe_unused]] Audio::Format format)
-{
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStats.reset();
-	audioStatsTimer.run(Seconds(1), Seconds(1), {},
-		[format]()
-		{
-			auto frames = format.bytesToFrames(audioStats.callbackBytes);
-			emuViewController.updateEmuAudioStats(audioStats.underruns, audioStats.overruns,
-				audioStats.callbacks, frames / (double)audioStats.callbacks, frames);
-			audioStats.callbacks = 0;
-			audioStats.callbackBytes = 0;
-		});
-	#endif
-}
-
-static void stopAudioStats()
-{
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStatsTimer.deinit();
-	clearEmuAudioStats();
-	#endif
-}
-
-EmuAudio::EmuAudio(ApplicationContext ctx):
+EmuAudio::EmuAudio(ApplicationContext ctx, FrameTrace &frameTrace):
 	manager{ctx},
+	frameTracePtr{&frameTrace},
 	defaultRate{AppMeta::forcedSoundRate ? AppMeta::forcedSoundRate : manager.nativeRate()},
 	rate_{defaultRate} {}
 
@@ -151,7 +123,8 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 	if(!audioStream.isOpen())
 	{
 		resizeAudioBuffer(targetBufferFillBytes);
-		audioWriteState = AudioWriteState::BUFFER;
+		resampler = {inputFormat};
+		stopReads();
 		Audio::Format outputFormat{inputFormat.rate, manager.nativeSampleFormat(), inputFormat.channels};
 		Audio::OutputStreamConfig outputConf
 		{
@@ -160,10 +133,11 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 			{
 				Audio::Format outputFormat{{}, outputSampleFormat, channels};
 				#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-				audioStats.callbacks++;
-				audioStats.callbackBytes += bytes;
+				callbacks.store(callbacks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				callbackFrames.store(callbackFrames.load(std::memory_order_relaxed) + frames, std::memory_order_relaxed);
 				#endif
-				if(audioWriteState == AudioWriteState::ACTIVE)
+				auto underrunCount = underruns.load(std::memory_order_relaxed);
+				if(readsStartedAt.load(std::memory_order_acquire) == underrunCount)
 				{
 					Audio::Format inputFormat = {{}, inputSampleFormat, channels};
 					auto span = rBuff.beginRead(inputFormat.framesToBytes(frames));
@@ -179,16 +153,11 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 						if(now - lastUnderrunTime < Seconds(1))
 						{
 							//log.warn("multiple underruns within a short time");
-							audioWriteState = AudioWriteState::MULTI_UNDERRUN;
-						}
-						else
-						{
-							audioWriteState = AudioWriteState::UNDERRUN;
+							multiUnderruns.store(multiUnderruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 						}
 						lastUnderrunTime = now;
-						#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-						audioStats.underruns++;
-						#endif
+						// stops reads until the emulation thread refills the buffer
+						underruns.store(underrunCount + 1, std::memory_order_release);
 					}
 					return true;
 				}
@@ -200,33 +169,45 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 			}
 		};
 		outputConf.wantedLatencyHint = {};
-		startAudioStats(inputFormat);
+		#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+		resetStats();
+		#endif
 		audioStream.open(outputConf);
 	}
 	else
 	{
-		startAudioStats(inputFormat);
+		#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+		resetStats();
+		#endif
 		if(shouldStartAudioWrites())
 		{
 			if(Config::DEBUG_BUILD)
 				log.info("resuming audio writes with buffer fill {}/{} bytes", rBuff.size(), rBuff.capacity());
-			audioWriteState = AudioWriteState::ACTIVE;
+			startReads();
 		}
 		else
 		{
-			audioWriteState = AudioWriteState::BUFFER;
+			stopReads();
 		}
 		audioStream.play();
 	}
 }
 
+// allocates the sample buffer without an output stream so frames can be written and discarded
+void EmuAudio::openWithoutOutput(FloatSeconds bufferDuration)
+{
+	targetBufferFillBytes = format().timeToBytes(bufferDuration);
+	bufferIncrementBytes = 0;
+	resizeAudioBuffer(targetBufferFillBytes);
+}
+
 void EmuAudio::stop()
 {
-	stopAudioStats();
-	audioWriteState = AudioWriteState::BUFFER;
+	stopReads();
 	if(audioStream)
 		audioStream.close();
 	rBuff.clear();
+	resampler.reset();
 }
 
 void EmuAudio::close()
@@ -234,17 +215,18 @@ void EmuAudio::close()
 	stop();
 	audioStream.reset();
 	rBuff.reset();
+	resampler = {};
 }
 
 void EmuAudio::flush()
 {
 	if(!audioStream) [[unlikely]]
 		return;
-	stopAudioStats();
-	audioWriteState = AudioWriteState::BUFFER;
+	stopReads();
 	if(audioStream)
 		audioStream.flush();
 	rBuff.clear();
+	resampler.reset();
 }
 
 void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
@@ -252,10 +234,15 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 	if(!framesToWrite) [[unlikely]]
 		return;
 	assume(rBuff.capacity());
+	frameTracePtr->record(FrameTraceEvent::audioWrite);
 	auto inputFormat = format();
-	switch(audioWriteState)
+	bool readsActive = readsStartedAt.load(std::memory_order_relaxed) == underruns.load(std::memory_order_acquire);
+	if(!readsActive)
 	{
-		case AudioWriteState::MULTI_UNDERRUN:
+		if(auto multiUnderrunCount = multiUnderruns.load(std::memory_order_relaxed);
+			multiUnderrunCount != seenMultiUnderruns)
+		{
+			seenMultiUnderruns = multiUnderrunCount;
 			if(speedMultiplier == 1. && addSoundBuffersOnUnderrun &&
 				inputFormat.bytesToTime(rBuff.capacity()).count() <= 1.) // hard cap buffer increase to 1 sec
 			{
@@ -263,12 +250,14 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 				targetBufferFillBytes += bufferIncrementBytes;
 				resizeAudioBuffer(targetBufferFillBytes);
 			}
-			[[fallthrough]];
-		case AudioWriteState::UNDERRUN:
-			audioWriteState = AudioWriteState::BUFFER;
-		break;
-		default:
-		break;
+		}
+	}
+	if(resampler && (speedMultiplier != 1. || rateControl_))
+	{
+		auto bytes = inputFormat.framesToBytes(writeResampledFrames(samples, framesToWrite, inputFormat));
+		if(!readsActive && shouldStartAudioWrites(bytes))
+			startReads();
+		return;
 	}
 	const size_t sampleFrames = framesToWrite;
 	if(speedMultiplier != 1.) [[unlikely]]
@@ -294,14 +283,14 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 		{
 			log.info("overrun, only {} out of {} bytes free", span.size(), bytes);
 			#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-			audioStats.overruns++;
+			overruns.store(overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 			#endif
 			auto freeFrames = inputFormat.bytesToFrames(span.size());
 			simpleResample(span.data(), freeFrames, samples, sampleFrames, inputFormat);
 		}
 		rBuff.endWrite(span);
 	}
-	if(audioWriteState == AudioWriteState::BUFFER && shouldStartAudioWrites(bytes))
+	if(!readsActive && shouldStartAudioWrites(bytes))
 	{
 		if(Config::DEBUG_BUILD)
 		{
@@ -310,8 +299,37 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 			log.info("starting audio writes with buffer fill {}/{} bytes {}/{} secs",
 				bytes, capacity, inputFormat.bytesToTime(bytes), inputFormat.bytesToTime(capacity));
 		}
-		audioWriteState = AudioWriteState::ACTIVE;
+		startReads();
+	}
+}
+
+double EmuAudio::rateControlAdjustment() const
+{
+	if(!rateControl_ || !targetBufferFillBytes)
+		return 1.;
+	// produce slightly more frames when below the fill target and less when above it,
+	// quantized to 1/10 of the max delta so the resampler filter isn't rebuilt every write
+	auto fillError = std::clamp((double(targetBufferFillBytes) - double(rBuff.size())) / targetBufferFillBytes, -1., 1.);
+	return 1. + std::round(fillError * 10.) / 10. * maxRateControlDelta;
+}
+
+size_t EmuAudio::writeResampledFrames(const void *samples, size_t frames, Audio::Format inputFormat)
+{
+	resampler.setRatio(speedMultiplier / rateControlAdjustment());
+	// request a couple extra frames since the resampler's fractional position can round up
+	size_t outFrames = std::ceil(frames / resampler.ratio()) + 2;
+	auto span = rBuff.beginWrite(inputFormat.framesToBytes(outFrames));
+	auto freeFrames = inputFormat.bytesToFrames(span.size());
+	if(freeFrames < outFrames - 2)
+	{
+		log.info("overrun, only {} out of {} frames free", freeFrames, outFrames);
+		#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+		overruns.store(overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		#endif
 	}
+	auto writtenFrames = resampler.process(span.data(), freeFrames, samples, frames);
+	rBuff.endWrite({span.first(inputFormat.framesToBytes(writtenFrames)), span.idxs});
+	return writtenFrames;
 }
 
 void EmuAudio::setRate(int newRate)
@@ -367,6 +385,33 @@ void EmuAudio::updateVolume()
 
 void EmuAudio::updateAddBuffersOnUnderrun() { addSoundBuffersOnUnderrun = speedMultiplier == 1. ? addSoundBuffersOnUnderrunSetting : false; }
 
+#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+AudioStats EmuAudio::stats() const
+{
+	auto callbackCount = int(callbacks.load(std::memory_order_relaxed)) - statsBase.callbacks;
+	auto frames = int(callbackFrames.load(std::memory_order_relaxed)) - statsBase.frames;
+	return
+	{
+		.underruns = int(underruns.load(std::memory_order_relaxed)) - statsBase.underruns,
+		.overruns = int(overruns.load(std::memory_order_relaxed)) - statsBase.overruns,
+		.callbacks = callbackCount,
+		.avgCallbackFrames = callbackCount ? frames / double(callbackCount) : 0.,
+		.frames = frames,
+	};
+}
+
+void EmuAudio::resetStats()
+{
+	statsBase =
+	{
+		.underruns = int(underruns.load(std::memory_order_relaxed)),
+		.overruns = int(overruns.load(std::memory_order_relaxed)),
+		.callbacks = int(callbacks.load(std::memory_order_relaxed)),
+		.frames = int(callbackFrames.load(std::memory_order_relaxed)),
+	};
+}
+#endif
+
 constexpr bool isValidVolumeSetting(int8_t vol) { return vol >= 0 && vol <= 125; }
 
 bool EmuAudio::setMaxVolume(int8_t vol)
@@ -436,6 +481,7 @@ void EmuAudio::writeConfig(FileIO &io) const
 	writeOptionValueIfNotDefault(io, CFGKEY_SOUND_VOLUME, maxVolume(), 100);
 	writeOptionValueIfNotDefault(io, CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN, addSoundBuffersOnUnderrunSetting, false);
 	writeOptionValueIfNotDefault(io, CFGKEY_AUDIO_API, audioAPI, Audio::Api::DEFAULT);
+	writeOptionValueIfNotDefault(io, CFGKEY_AUDIO_RATE_CONTROL, rateControl_, false);
 }
 
 bool EmuAudio::readConfig(MapIO &io, unsigned key)
@@ -448,6 +494,7 @@ bool EmuAudio::readConfig(MapIO &io, unsigned key)
 		case CFGKEY_SOUND_VOLUME: return readOptionValue<int8_t>(io, [&](auto v){ setMaxVolume(v); }, isValidVolumeSetting);
 		case CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN: return readOptionValue(io, addSoundBuffersOnUnderrunSetting);
 		case CFGKEY_AUDIO_API: return readOptionValue(io, audioAPI);
+		case CFGKEY_AUDIO_RATE_CONTROL: return readOptionValue(io, rateControl_);
 	}
 	return false;
 }
@@ -184,6 +184,12 @@ bool InputManager::handleAppActionKeyInput(EmuApp& app, InputAction action, cons
 		break;
 		case rewind:
 		{
+			if(app.rewindManager.frameInterval())
+			{
+				// emulation thread steps back while the key is held
+				app.rewindManager.setRewinding(isPushed);
+				break;
+			}
 			if(!isPushed)
 				break;
 			app.rewindManager.rewindState(app);
@@ -220,6 +226,8 @@ void InputManager::handleSystemKeyInput(EmuApp& app, KeyInfo keyInfo, Input::Act
 {
 	if(flags.allowTurboModifier && turboModifierActive && std::ranges::all_of(keyInfo.codes, AppMeta::allowsTurboModifier))
 		keyInfo.flags.turbo = 1;
+	app.runAheadManager.onInputChanged();
+	app.frameTrace.record(FrameTraceEvent::input);
 	if(keyInfo.flags.toggle)
 	{
 		toggleInput.updateEvent(app, keyInfo, act);
@@ -238,6 +246,44 @@ void InputManager::handleSystemKeyInput(EmuApp& app, KeyInfo keyInfo, Input::Act
 	}
 }
 
+bool InputManager::handleQueuedKeyEvent(EmuApp& app, const Input::KeyEvent &keyEv)
+{
+	// runs on the emulation thread before each frame and from SubFrameInput polls during it, only keys
+	// mapped to plain system actions are handled here and everything else is left for EmuInputView
+	if(keyEv.repeated() || turboModifierActive || vController.isInKeyboardMode())
+		return false;
+	auto &devData = inputDevData(*keyEv.device());
+	if(!devData.actionTable.size() || devData.keyCombos.size()) [[unlikely]]
+		return false;
+	const auto &actionGroup = devData.actionTable[keyEv.key()];
+	if(!actionGroup[0] || std::ranges::any_of(actionGroup, [](KeyInfo k){ return k.flags.appCode || k.flags.turbo || k.flags.toggle; }))
+		return false;
+	bool isPushed = keyEv.pushed();
+	app.runAheadManager.onInputChanged();
+	app.frameTrace.record(FrameTraceEvent::input);
+	auto &subFrameInput = app.system().subFrameInput;
+	bool queueActions = subFrameInput.isActive() || subFrameInput.hasQueuedActions();
+	for(auto keyInfo : actionGroup)
+	{
+		if(!keyInfo)
+			break;
+		for(auto code : keyInfo.codes)
+		{
+			InputAction action{code, keyInfo.flags, keyEv.state(), keyEv.metaKeyBits()};
+			if(!queueActions || !subFrameInput.queue(action, keyEv.time()))
+				app.system().handleInputAction(&app, action);
+		}
+		if(vController.highlightPushedButtons)
+		{
+			app.runOnMainThread([&app, keyInfo, isPushed](ApplicationContext)
+			{
+				app.defaultVController().updateSystemKeys(keyInfo, isPushed);
+			});
+		}
+	}
+	return true;
+}
+
 void InputManager::updateInputDevices(ApplicationContext ctx)
 {
 	for(auto &devPtr : ctx.inputDevices())
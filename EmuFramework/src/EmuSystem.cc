@@ -44,14 +44,14 @@ bool EmuApp::shouldOverwriteExistingState() const
 
 void EmuSystem::loadState(EmuApp &app, CStringView uri)
 {
-	auto file = appContext().openFileUri(uri, {.accessHint = IOAccessHint::All});
-	readState(app, file.buffer(IOBufferMode::Release));
+	IO file = appContext().openFileUri(uri, {.accessHint = IOAccessHint::All});
+	readStateStream(app, file);
 }
 
 void EmuSystem::saveState(CStringView uri)
 {
-	auto file = appContext().openFileUri(uri, OpenFlags::newFile());
-	file.write(saveState().span());
+	IO file = appContext().openFileUri(uri, OpenFlags::newFile());
+	writeStateStream(file);
 }
 
 DynArray<uint8_t> EmuSystem::saveState()
@@ -156,6 +156,7 @@ void EmuSystem::clearGamePaths()
 	contentFileName_ = {};
 	contentDirectory_ = {};
 	contentLocation_ = {};
+	contentCacheDirectory_ = {};
 	contentSaveDirectory_ = {};
 }
 
@@ -245,6 +246,7 @@ void EmuSystem::closeRuntimeSystem(EmuApp &app)
 		closeSystem();
 		app.autosaveManager.cancelTimer();
 		app.rewindManager.clear();
+		app.runAheadManager.clear();
 		state = State::OFF;
 	}
 	clearGamePaths();
@@ -276,15 +278,19 @@ void EmuSystem::start(EmuApp &app)
 	if(AppMeta::inputHasKeyboard)
 		app.defaultVController().keyboard().setShiftActive(false);
 	clearInputBuffers();
+	subFrameInput.clear();
 	resetFrameTiming();
 	onStart();
 	app.startAudio();
 	app.autosaveManager.startTimer();
-	if(AppMeta::stateSizeChangesAtRuntime && app.rewindManager.maxStates)
+	app.runAheadManager.invalidateSnapshots();
+	if(AppMeta::stateSizeChangesAtRuntime && (app.rewindManager.maxStates || app.runAheadManager.frames()))
 	{
 		auto newStateSize = stateSize();
-		if(newStateSize != app.rewindManager.stateSize)
+		if(app.rewindManager.maxStates && newStateSize != app.rewindManager.stateSize)
 			app.rewindManager.reset(newStateSize);
+		if(app.runAheadManager.frames())
+			app.runAheadManager.reset(newStateSize);
 	}
 	app.rewindManager.startTimer();
 }
@@ -391,7 +397,24 @@ void EmuSystem::loadContentFromPath(CStringView pathStr, std::string_view displa
 
 void EmuSystem::loadContentFromFile(IO file, CStringView path, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
 {
-	if(!AppMeta::handlesArchiveFiles && EmuApp::hasArchiveExtension(displayName))
+	bool isArchive = EmuApp::hasArchiveExtension(displayName);
+	auto cachedContent = isArchive ? EmuApp::get(appContext()).archiveContentCache.content(appContext(), path)
+		: ArchiveContentCache::Content{};
+	if(!AppMeta::handlesArchiveFiles && cachedContent)
+	{
+		auto it = std::ranges::find_if(cachedContent.entries, [](auto &e){ return AppMeta::defaultFsFilter(e.name); });
+		if(it == cachedContent.entries.end())
+		{
+			throw std::runtime_error("No recognized file extensions in archive");
+		}
+		log.info("loading cached archive file entry:{}", it->name);
+		IO io{FileIO{cachedContent.filePath(it->name), {.accessHint = IOAccessHint::Sequential}}};
+		closeAndSetupNew(path, displayName);
+		contentFileName_ = it->name;
+		contentCacheDirectory_ = cachedContent.directory;
+		loadContent(io, params, onLoadProgress);
+	}
+	else if(!AppMeta::handlesArchiveFiles && isArchive)
 	{
 		IO io{};
 		FS::FileString originalName{};
@@ -421,6 +444,7 @@ void EmuSystem::loadContentFromFile(IO file, CStringView path, std::string_view
 	else
 	{
 		closeAndSetupNew(path, displayName);
+		contentCacheDirectory_ = cachedContent.directory;
 		loadContent(file, params, onLoadProgress);
 	}
 }
@@ -55,6 +55,11 @@ void EmuSystemTask::start(Window& win)
 			auto eventLoop = EventLoop::makeForThread();
 			window().setFrameEventsOnThisThread();
 			addOnFrameDelayed();
+			// game keys from the input thread are applied right before each frame instead of waiting on the main thread
+			app.appContext().setQueuedKeyEventHandler([this](const Input::KeyEvent &e)
+			{
+				return app.inputManager.handleQueuedKeyEvent(app, e);
+			});
 			bool started = true;
 			commandPort.attach(eventLoop, [this, &started](auto msgs)
 			{
@@ -84,6 +89,7 @@ void EmuSystemTask::start(Window& win)
 						[&](ExitCommand&)
 						{
 							started = false;
+							app.appContext().setQueuedKeyEventHandler({});
 							removeOnFrame();
 							window().removeFrameEvents();
 							threadId_ = 0;
@@ -132,7 +138,8 @@ void EmuSystemTask::drawWindowNow()
 
 EmuSystemTask::SuspendContext EmuSystemTask::suspend()
 {
-	if(!isStarted() || isSuspended)
+	// input handled on the emulation thread runs between frames so it's already safe to modify the system
+	if(!isStarted() || isSuspended || thisThreadId() == threadId_)
 		return {};
 	//log.info("suspending emulation thread");
 	commandPort.send({.command = SuspendCommand{}}, MessageReplyMode::wait);
@@ -439,8 +446,26 @@ bool EmuSystemTask::advanceFrames(FrameParams frameParams)
 		app.record(FrameTimingStatEvent::startOfEmulation);
 		shouldWait = setWaitForPresent();
 	}
+	bool rewinding = app.rewindManager.rewindFrame(app);
+	if(rewinding)
+	{
+		// show one frame from the restored state with audio muted
+		frameInfo.advanced = 1;
+		audioPtr = nullptr;
+		app.runAheadManager.invalidateSnapshots();
+	}
+	app.appContext().dispatchQueuedInputEvents();
 	//log.debug("running {} frame(s), skip:{}", frameInfo.advanced, !videoPtr);
-	sys.runFrames({this}, videoPtr, audioPtr, frameInfo.advanced);
+	app.frameTrace.nextFrame();
+	app.frameTrace.record(FrameTraceEvent::runFrameStart);
+	// run-ahead frames are emulated from the same input so only apply it mid-frame without them
+	if(app.appContext().hasInputThread() && !app.runAheadManager.frames())
+		sys.subFrameInput.beginFrame(app, SteadyClock::now(), sys.frameRate().duration());
+	app.runAheadManager.runFrames({this}, app, videoPtr, audioPtr, frameInfo.advanced);
+	sys.subFrameInput.endFrame(app);
+	app.frameTrace.record(FrameTraceEvent::runFrameEnd);
+	if(!rewinding)
+		app.rewindManager.captureFrames(sys, frameInfo.advanced);
 	app.inputManager.turboActions.update(app);
 	if(!videoPtr)
 		return false;
@@ -454,11 +479,16 @@ bool EmuSystemTask::advanceFrames(FrameParams frameParams)
 	app.record(FrameTimingStatEvent::endOfFrame, endFrameTime);
 	viewCtrl.emuView.setFrameTimingStats({.stats{app.frameTimingStats}, .lastFrameTime{frameParams.lastTime},
 		.inputRate{sys.frameRate()}, .outputRate{frameRateConfig.rate}});
+	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+	if(audioPtr)
+		viewCtrl.emuView.setAudioStats(audioPtr->stats());
+	#endif
 	return true;
 }
 
 void EmuSystemTask::notifyWindowPresented()
 {
+	app.frameTrace.record(FrameTraceEvent::present);
 	if(waitingForPresent_)
 	{
 		waitingForPresent_ = false;
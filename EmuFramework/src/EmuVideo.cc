@@ -133,6 +133,7 @@ void EmuVideo::startUnchangedFrame(EmuSystemTaskContext taskCtx)
 
 void EmuVideo::postFrameFinished(EmuSystemTaskContext taskCtx)
 {
+	app().frameTrace.record(FrameTraceEvent::videoFrameFinished);
 	if(taskCtx)
 	{
 		taskCtx.task().sendFrameFinishedReply(*this);
@@ -227,6 +228,12 @@ void EmuVideoImage::endFrame()
 	emuVideo->finishFrame(taskCtx, texBuff);
 }
 
+void EmuVideoImage::cancelFrame()
+{
+	assume(texBuff);
+	emuVideo->image().unlock(texBuff, {.discard = true});
+}
+
 WSize EmuVideo::size() const
 {
 	if(!vidImg)
@@ -0,0 +1,145 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/FrameTrace.hh>
+import imagine;
+
+namespace EmuEx
+{
+
+std::string_view asString(FrameTraceEvent event)
+{
+	switch(event)
+	{
+		case FrameTraceEvent::input: return "input";
+		case FrameTraceEvent::runFrameStart: return "runFrameStart";
+		case FrameTraceEvent::runFrameEnd: return "runFrameEnd";
+		case FrameTraceEvent::videoFrameFinished: return "videoFrameFinished";
+		case FrameTraceEvent::present: return "present";
+		case FrameTraceEvent::audioWrite: return "audioWrite";
+	}
+	return "unknown";
+}
+
+void FrameTrace::recordAlways(FrameTraceEvent event, SteadyClockTimePoint time)
+{
+	auto idx = writeIdx.fetch_add(1, std::memory_order_relaxed);
+	auto &slot = slots[idx % capacity];
+	slot.seq.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	auto timeNs = duration_cast<Nanoseconds>((hasTime(time) ? time : SteadyClock::now()).time_since_epoch()).count();
+	slot.timeNs.store(timeNs, std::memory_order_relaxed);
+	slot.frame.store(frame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	slot.event.store(std::to_underlying(event), std::memory_order_relaxed);
+	slot.seq.store(idx + 1, std::memory_order_release);
+}
+
+void FrameTrace::clear()
+{
+	for(auto &slot : slots)
+	{
+		slot.seq.store(0, std::memory_order_relaxed);
+	}
+}
+
+std::vector<FrameTraceRecord> FrameTrace::records() const
+{
+	auto endIdx = writeIdx.load(std::memory_order_acquire);
+	auto startIdx = endIdx > capacity ? endIdx - capacity : 0;
+	std::vector<FrameTraceRecord> recs;
+	recs.reserve(endIdx - startIdx);
+	for(auto idx = startIdx; idx < endIdx; idx++)
+	{
+		auto &slot = slots[idx % capacity];
+		if(slot.seq.load(std::memory_order_acquire) != idx + 1)
+			continue; // cleared, not finished, or already overwritten
+		FrameTraceRecord rec
+		{
+			.time = SteadyClockTimePoint{duration_cast<SteadyClockDuration>(Nanoseconds{slot.timeNs.load(std::memory_order_relaxed)})},
+			.frame = slot.frame.load(std::memory_order_relaxed),
+			.event = FrameTraceEvent(slot.event.load(std::memory_order_relaxed)),
+		};
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if(slot.seq.load(std::memory_order_relaxed) != idx + 1)
+			continue;
+		recs.emplace_back(rec);
+	}
+	// events from different threads can claim slots slightly out of time order
+	std::ranges::stable_sort(recs, {}, &FrameTraceRecord::time);
+	return recs;
+}
+
+static auto timeMicroseconds(SteadyClockTimePoint time, SteadyClockTimePoint startTime)
+{
+	return duration_cast<std::chrono::duration<double, std::micro>>(time - startTime).count();
+}
+
+// groups events into rows of the trace viewer by the part of the frame they belong to
+static int traceThreadId(FrameTraceEvent event)
+{
+	switch(event)
+	{
+		case FrameTraceEvent::input: return 0;
+		case FrameTraceEvent::runFrameStart:
+		case FrameTraceEvent::runFrameEnd:
+		case FrameTraceEvent::videoFrameFinished: return 1;
+		case FrameTraceEvent::present: return 2;
+		case FrameTraceEvent::audioWrite: return 3;
+	}
+	return 0;
+}
+
+void FrameTrace::writeChromeTrace(FileIO &io) const
+{
+	auto recs = records();
+	auto startTime = recs.size() ? recs.front().time : SteadyClockTimePoint{};
+	std::string str{"{\"traceEvents\":[\n"};
+	for(bool isFirst = true; const auto &rec : recs)
+	{
+		if(!std::exchange(isFirst, false))
+			str += ",\n";
+		std::string_view phase = "i", name = asString(rec.event);
+		if(rec.event == FrameTraceEvent::runFrameStart)
+		{
+			phase = "B";
+			name = "runFrame";
+		}
+		else if(rec.event == FrameTraceEvent::runFrameEnd)
+		{
+			phase = "E";
+			name = "runFrame";
+		}
+		std::format_to(std::back_inserter(str),
+			"{{\"name\":\"{}\",\"ph\":\"{}\",\"ts\":{:.3f},\"pid\":0,\"tid\":{},\"s\":\"t\",\"args\":{{\"frame\":{}}}}}",
+			name, phase, timeMicroseconds(rec.time, startTime), traceThreadId(rec.event), rec.frame);
+	}
+	str += "\n]}\n";
+	io.write(str.data(), str.size());
+}
+
+void FrameTrace::writeCSV(FileIO &io) const
+{
+	auto recs = records();
+	auto startTime = recs.size() ? recs.front().time : SteadyClockTimePoint{};
+	std::string str{"frame,event,time_us\n"};
+	for(const auto &rec : recs)
+	{
+		std::format_to(std::back_inserter(str), "{},{},{:.3f}\n",
+			rec.frame, asString(rec.event), timeMicroseconds(rec.time, startTime));
+	}
+	io.write(str.data(), str.size());
+}
+
+}
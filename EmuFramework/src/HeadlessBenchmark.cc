@@ -0,0 +1,166 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/HeadlessBenchmark.hh>
+#include <emuframework/EmuApp.hh>
+#include <sys/resource.h>
+#if defined __linux__ && !defined __ANDROID__
+#include <spawn.h>
+#include <sys/wait.h>
+#define CAN_SPAWN_JOBS
+extern char **environ;
+#endif
+import imagine;
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"Benchmark"};
+
+static int parseInt(std::string_view str)
+{
+	int val{};
+	std::from_chars(str.data(), str.data() + str.size(), val);
+	return val;
+}
+
+std::optional<HeadlessBenchmarkParams> parseHeadlessBenchmarkArgs(CommandArgs args)
+{
+	if(args.c < 3 || std::string_view{args.v[1]} != "--benchmark")
+		return {};
+	HeadlessBenchmarkParams params{.contentPath = args.v[2]};
+	for(auto arg : std::span{args.v + 3, size_t(args.c - 3)})
+	{
+		std::string_view argStr{arg};
+		if(argStr.starts_with("--frames="))
+		{
+			params.frames = std::max(1, parseInt(argStr.substr(9)));
+		}
+		else if(argStr == "--audio")
+		{
+			params.audio = true;
+		}
+		else if(argStr == "--jobs")
+		{
+			params.jobs = 0;
+		}
+		else if(argStr.starts_with("--jobs="))
+		{
+			params.jobs = std::max(0, parseInt(argStr.substr(7)));
+		}
+		else
+		{
+			log.warn("ignoring unknown argument:{}", argStr);
+		}
+	}
+	return params;
+}
+
+static long peakRSSKiB()
+{
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	if constexpr(Config::envIsMacOSX || Config::envIsIOS)
+		return usage.ru_maxrss / 1024;
+	else
+		return usage.ru_maxrss;
+}
+
+static int spawnJobs([[maybe_unused]] int jobs, [[maybe_unused]] CommandArgs args)
+{
+	#ifdef CAN_SPAWN_JOBS
+	// each job is a separate process since cores keep their state in globals,
+	// they get the same arguments with --jobs removed
+	std::vector<char*> jobArgs;
+	for(auto arg : std::span{args.v, size_t(args.c)})
+	{
+		if(!std::string_view{arg}.starts_with("--jobs"))
+			jobArgs.emplace_back(arg);
+	}
+	jobArgs.emplace_back(nullptr);
+	std::vector<pid_t> pids;
+	for(auto i : iotaCount(jobs))
+	{
+		pid_t pid;
+		if(auto err = posix_spawn(&pid, "/proc/self/exe", nullptr, nullptr, jobArgs.data(), environ); err)
+		{
+			std::println(stderr, "error:{} spawning job:{}", std::strerror(err), i);
+			continue;
+		}
+		pids.emplace_back(pid);
+	}
+	int failedJobs = jobs - pids.size();
+	for(auto pid : pids)
+	{
+		int status{};
+		if(waitpid(pid, &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status))
+			failedJobs++;
+	}
+	std::println("{} of {} jobs completed", jobs - failedJobs, jobs);
+	return failedJobs ? 1 : 0;
+	#else
+	std::println(stderr, "parallel jobs aren't supported on this platform");
+	return 1;
+	#endif
+}
+
+int runHeadlessBenchmark(EmuApp &app, HeadlessBenchmarkParams params, CommandArgs args)
+{
+	if(params.jobs != 1)
+	{
+		return spawnJobs(params.jobs ? params.jobs : app.appContext().cpuCount(), args);
+	}
+	auto &sys = app.system();
+	try
+	{
+		sys.createWithMedia({}, params.contentPath, app.appContext().fileUriDisplayName(params.contentPath), {},
+			[](int, int, const char*){ return true; });
+	}
+	catch(std::exception &err)
+	{
+		std::println(stderr, "error loading {}: {}", params.contentPath, err.what());
+		return 1;
+	}
+	EmuAudio *audioPtr{};
+	if(params.audio)
+	{
+		app.audio.openWithoutOutput(sys.frameRate().duration());
+		sys.configFrameRate(app.audio.rate(), sys.frameRate().duration());
+		audioPtr = &app.audio;
+	}
+	std::vector<SteadyClockDuration> frameTimes(params.frames);
+	log.info("running {} frames of {}", params.frames, sys.contentDisplayName());
+	auto startTime = SteadyClock::now();
+	for(auto &frameTime : frameTimes)
+	{
+		auto frameStartTime = SteadyClock::now();
+		sys.runFrame({}, nullptr, audioPtr);
+		if(audioPtr)
+			audioPtr->discardFrames();
+		frameTime = SteadyClock::now() - frameStartTime;
+	}
+	auto totalTime = duration_cast<FloatSeconds>(SteadyClock::now() - startTime);
+	std::ranges::sort(frameTimes);
+	auto percentile = [&](size_t p)
+	{
+		return duration_cast<std::chrono::duration<double, std::micro>>(frameTimes[(frameTimes.size() - 1) * p / 100]).count();
+	};
+	std::println("{}: {} frames in {:.3f}s, {:.2f} fps, p50:{:.1f}us p99:{:.1f}us peak RSS:{}KiB",
+		sys.contentDisplayName(), params.frames, totalTime.count(), params.frames / totalTime.count(),
+		percentile(50), percentile(99), peakRSSKiB());
+	return 0;
+}
+
+}
@@ -25,6 +25,104 @@ using namespace IG;
 
 constexpr SystemLogger log{"RewindMgr"};
 constexpr Seconds defaultSaveFreq{1};
+// equal byte runs shorter than this are folded into the surrounding literal to avoid record overhead
+constexpr size_t minDeltaSkipLength = 8;
+
+static void writeVarint(std::vector<uint8_t> &out, size_t val)
+{
+	while(val >= 0x80)
+	{
+		out.push_back(uint8_t(val) | 0x80);
+		val >>= 7;
+	}
+	out.push_back(uint8_t(val));
+}
+
+static size_t readVarint(const uint8_t *&p)
+{
+	size_t val{};
+	for(int shift = 0;; shift += 7)
+	{
+		auto b = *p++;
+		val |= size_t(b & 0x7F) << shift;
+		if(!(b & 0x80))
+			return val;
+	}
+}
+
+static size_t matchingBytes(const uint8_t *a, const uint8_t *b, size_t size)
+{
+	size_t i{};
+	for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+	{
+		uint64_t wordA, wordB;
+		std::memcpy(&wordA, a + i, sizeof(uint64_t));
+		std::memcpy(&wordB, b + i, sizeof(uint64_t));
+		if(wordA != wordB)
+			break;
+	}
+	while(i < size && a[i] == b[i])
+		i++;
+	return i;
+}
+
+// Encodes older ^ newer as a series of (skip length, literal length, literal bytes) records,
+// preceded by the size of the older state
+static void encodeXorDelta(std::vector<uint8_t> &out, size_t olderSize, std::span<const uint8_t> older, std::span<const uint8_t> newer)
+{
+	assume(older.size() == newer.size());
+	out.clear();
+	writeVarint(out, olderSize);
+	const auto size = older.size();
+	size_t pos{};
+	while(pos < size)
+	{
+		auto skip = matchingBytes(&older[pos], &newer[pos], size - pos);
+		auto litStart = pos + skip;
+		if(litStart == size)
+			break;
+		auto litEnd = litStart + 1;
+		for(auto i = litEnd; i < size;)
+		{
+			auto equalRun = matchingBytes(&older[i], &newer[i], std::min(size - i, minDeltaSkipLength));
+			if(equalRun == minDeltaSkipLength || i + equalRun == size)
+				break;
+			i += equalRun + 1;
+			litEnd = i;
+		}
+		writeVarint(out, skip);
+		writeVarint(out, litEnd - litStart);
+		for(auto i = litStart; i < litEnd; i++)
+		{
+			out.push_back(older[i] ^ newer[i]);
+		}
+		pos = litEnd;
+	}
+	if(out.capacity() > out.size() * 2)
+		out.shrink_to_fit();
+}
+
+// Applies an encoded delta in-place, returning the size of the reconstructed state
+static size_t applyXorDelta(std::span<uint8_t> buff, std::span<const uint8_t> delta)
+{
+	auto p = delta.data();
+	const auto end = p + delta.size();
+	auto stateSize = readVarint(p);
+	size_t pos{};
+	while(p < end)
+	{
+		pos += readVarint(p);
+		auto len = readVarint(p);
+		assume(pos + len <= buff.size());
+		for(auto i : iotaCount(len))
+		{
+			buff[pos + i] ^= p[i];
+		}
+		p += len;
+		pos += len;
+	}
+	return stateSize;
+}
 
 RewindManager::RewindManager(EmuApp &app):
 	saveTimer
@@ -40,10 +138,23 @@ RewindManager::RewindManager(EmuApp &app):
 		}
 	} {}
 
+RewindManager::~RewindManager()
+{
+	stopCaptureThread();
+}
+
 void RewindManager::clear()
 {
 	saveTimer.cancel();
+	stopCaptureThread();
 	stateEntries = {};
+	deltaEntries = {};
+	keyState = {};
+	scratchState = {};
+	captureBuffers[0] = {};
+	captureBuffers[1] = {};
+	keyStateSize = 0;
+	deltaCount = 0;
 	stateIdx = 0;
 	stateSize = 0;
 }
@@ -52,12 +163,41 @@ bool RewindManager::reset()
 {
 	if(!stateSize)
 		return true;
+	stopCaptureThread();
 	try
 	{
-		if(maxStates)
-			log.info("allocating {} states of size:{}", maxStates, stateSize);
-		stateEntries.reset(maxStates, stateSize);
 		stateIdx = 0;
+		keyStateSize = 0;
+		deltaCount = 0;
+		if(maxStates && storageMode_ == RewindStorageMode::Delta)
+		{
+			log.info("allocating {} delta states of size:{}", maxStates, stateSize);
+			stateEntries = {};
+			keyState.resetForOverwrite(stateSize);
+			scratchState.resetForOverwrite(stateSize);
+			deltaEntries = std::vector<std::vector<uint8_t>>(maxStates - 1);
+		}
+		else
+		{
+			if(maxStates)
+				log.info("allocating {} states of size:{}", maxStates, stateSize);
+			deltaEntries = {};
+			keyState = {};
+			scratchState = {};
+			stateEntries.reset(maxStates, stateSize);
+		}
+		if(maxStates && frameInterval_)
+		{
+			log.info("capturing states every {} frame(s)", frameInterval_);
+			captureBuffers[0].resetForOverwrite(stateSize);
+			captureBuffers[1].resetForOverwrite(stateSize);
+			startCaptureThread();
+		}
+		else
+		{
+			captureBuffers[0] = {};
+			captureBuffers[1] = {};
+		}
 		return true;
 	}
 	catch(...)
@@ -66,9 +206,38 @@ bool RewindManager::reset()
 	}
 }
 
+bool RewindManager::hasStorage() const
+{
+	return stateEntries.size() || keyState.size();
+}
+
+void RewindManager::setStorageMode(RewindStorageMode mode)
+{
+	if(mode == storageMode_)
+		return;
+	storageMode_ = mode;
+	reset();
+}
+
+void RewindManager::setFrameInterval(int8_t frames)
+{
+	if(frames == frameInterval_)
+		return;
+	frameInterval_ = frames;
+	framesUntilCapture = frames;
+	if(frames)
+		saveTimer.cancel();
+	reset();
+}
+
 void RewindManager::saveState(EmuApp &app)
 {
 	assume(maxStates);
+	if(storageMode_ == RewindStorageMode::Delta)
+	{
+		commitState(scratchState, app.writeState(scratchState, {.uncompressed = true}));
+		return;
+	}
 	assume(stateIdx < maxStates);
 	//log.debug("saving rewind state index:{}", stateIdx);
 	auto &entry = stateEntries[stateIdx];
@@ -76,24 +245,152 @@ void RewindManager::saveState(EmuApp &app)
 	entry.size = app.writeState({entry.data, stateSize}, {.uncompressed = true});
 }
 
+void RewindManager::commitState(DynArray<uint8_t> &state, size_t size)
+{
+	if(storageMode_ == RewindStorageMode::Full)
+	{
+		assume(stateIdx < maxStates);
+		auto &entry = stateEntries[stateIdx];
+		stateIdx = stateIdx + 1 == maxStates ? 0 : stateIdx + 1;
+		std::copy_n(state.data(), size, entry.data);
+		entry.size = size;
+		return;
+	}
+	// keep the padding past the state data zeroed so deltas always cover identical bytes
+	std::fill(state.begin() + size, state.end(), 0);
+	if(keyStateSize && deltaEntries.size())
+	{
+		assume(stateIdx < deltaEntries.size());
+		//log.debug("saving rewind delta index:{}", stateIdx);
+		encodeXorDelta(deltaEntries[stateIdx], keyStateSize, keyState, state);
+		stateIdx = stateIdx + 1 == deltaEntries.size() ? 0 : stateIdx + 1;
+		deltaCount = std::min(deltaCount + 1, deltaEntries.size());
+	}
+	std::swap(keyState, state);
+	keyStateSize = size;
+}
+
+bool RewindManager::loadNewestState(bool keepOldest, auto &&readState)
+{
+	if(storageMode_ == RewindStorageMode::Full)
+	{
+		assume(stateIdx < maxStates);
+		auto prevIdx = stateIdx ? stateIdx - 1 : maxStates - 1;
+		auto &entry = stateEntries[prevIdx];
+		if(!entry.size)
+			return false;
+		auto olderIdx = prevIdx ? prevIdx - 1 : maxStates - 1;
+		if(keepOldest && (maxStates == 1 || !stateEntries[olderIdx].size))
+		{
+			readState(std::span<uint8_t>{entry.data, entry.size});
+			return true;
+		}
+		log.info("rewinding to state index:{}", prevIdx);
+		readState(std::span<uint8_t>{entry.data, std::exchange(entry.size, 0)});
+		stateIdx = prevIdx;
+		return true;
+	}
+	if(!keyStateSize)
+		return false;
+	readState(std::span<uint8_t>{keyState.data(), keyStateSize});
+	if(deltaCount)
+	{
+		auto prevIdx = stateIdx ? stateIdx - 1 : deltaEntries.size() - 1;
+		auto &entry = deltaEntries[prevIdx];
+		keyStateSize = applyXorDelta(keyState, entry);
+		entry.clear();
+		deltaCount--;
+		stateIdx = prevIdx;
+	}
+	else if(!keepOldest)
+	{
+		keyStateSize = 0;
+	}
+	return true;
+}
+
 void RewindManager::rewindState(EmuApp &app)
 {
 	if(!maxStates)
 		return;
-	assume(stateIdx < maxStates);
-	auto prevIdx = stateIdx ? stateIdx - 1 : maxStates - 1;
-	auto &entry = stateEntries[prevIdx];
-	if(!entry.size)
+	if(loadNewestState(false, [&](std::span<uint8_t> state){ app.readState(state); }))
+		saveTimer.reset();
+}
+
+void RewindManager::captureFrames(EmuSystem &sys, int frames)
+{
+	if(!frameInterval_ || !captureThread.joinable())
+		return;
+	framesUntilCapture -= frames;
+	if(framesUntilCapture > 0)
+		return;
+	framesUntilCapture = frameInterval_;
+	if(pendingCaptures.load(std::memory_order::acquire) == 2)
+	{
+		// worker is still committing both buffers, skip this capture
+		return;
+	}
+	auto &buff = captureBuffers[captureWriteIdx];
+	captureSizes[captureWriteIdx] = sys.writeState(buff, {.uncompressed = true});
+	captureWriteIdx ^= 1;
+	pendingCaptures.fetch_add(1, std::memory_order::release);
+	captureSem.release();
+}
+
+bool RewindManager::rewindFrame(EmuApp &app)
+{
+	if(!frameInterval_ || !rewinding.load(std::memory_order::relaxed) || !captureThread.joinable())
+		return false;
+	waitForCaptures();
+	framesUntilCapture = frameInterval_;
+	// the oldest state stays in storage so holding rewind at the end of the buffer freezes on it
+	loadNewestState(true, [&](std::span<uint8_t> state){ app.system().readState(app, state); });
+	return true;
+}
+
+void RewindManager::startCaptureThread()
+{
+	assume(!captureThread.joinable());
+	quitCaptureThread = false;
+	captureThread = std::thread{[this]()
+	{
+		while(true)
+		{
+			captureSem.acquire();
+			if(quitCaptureThread)
+				return;
+			auto idx = std::exchange(captureReadIdx, captureReadIdx ^ 1);
+			commitState(captureBuffers[idx], captureSizes[idx]);
+			pendingCaptures.fetch_sub(1, std::memory_order::release);
+			pendingCaptures.notify_all();
+		}
+	}};
+}
+
+void RewindManager::stopCaptureThread()
+{
+	if(!captureThread.joinable())
 		return;
-	log.info("rewinding to state index:{}", prevIdx);
-	app.readState({entry.data, std::exchange(entry.size, 0)});
-	stateIdx = prevIdx;
-	saveTimer.reset();
+	quitCaptureThread = true;
+	captureSem.release();
+	captureThread.join();
+	while(captureSem.try_acquire()) {}
+	pendingCaptures.store(0, std::memory_order::relaxed);
+	captureWriteIdx = captureReadIdx = 0;
+	rewinding.store(false, std::memory_order::relaxed);
+}
+
+void RewindManager::waitForCaptures()
+{
+	while(auto pending = pendingCaptures.load(std::memory_order::acquire))
+	{
+		pendingCaptures.wait(pending, std::memory_order::acquire);
+	}
 }
 
 void RewindManager::startTimer()
 {
-	if(!stateEntries.size())
+	if(!hasStorage() || frameInterval_)
 		return;
 	saveTimer.start();
 }
@@ -101,6 +398,7 @@ void RewindManager::startTimer()
 void RewindManager::pauseTimer()
 {
 	saveTimer.pause();
+	setRewinding(false);
 }
 
 bool RewindManager::readConfig(MapIO &io, unsigned key)
@@ -114,6 +412,11 @@ bool RewindManager::readConfig(MapIO &io, unsigned key)
 			if(s > 0)
 				saveTimer.frequency = Seconds{s};
 		});
+		case CFGKEY_REWIND_FRAME_INTERVAL: return readOptionValue<int8_t>(io, [&](auto f)
+		{
+			frameInterval_ = framesUntilCapture = f;
+		}, [](auto f){ return f >= 0 && f <= maxRewindFrameInterval; });
+		case CFGKEY_REWIND_STORAGE_MODE: return readOptionValue(io, storageMode_, [](auto m){return m <= lastEnum<RewindStorageMode>;});
 	}
 }
 
@@ -121,6 +424,8 @@ void RewindManager::writeConfig(FileIO &io) const
 {
 	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_STATES, uint32_t(maxStates), 0u);
 	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_TIMER_SECS, int16_t(saveTimer.frequency.count()), defaultSaveFreq.count());
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_FRAME_INTERVAL, frameInterval_, int8_t{});
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_STORAGE_MODE, storageMode_, RewindStorageMode::Delta);
 }
 
 }
@@ -0,0 +1,201 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/RunAheadManager.hh>
+#include <emuframework/EmuApp.hh>
+#include <emuframework/Option.hh>
+import imagine;
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+constexpr SystemLogger log{"RunAheadMgr"};
+
+void RunAheadManager::clear()
+{
+	snapshots = {};
+	stateSize = 0;
+	invalidateSnapshots();
+}
+
+bool RunAheadManager::reset(size_t stateSize_)
+{
+	stateSize = stateSize_;
+	snapshots = {};
+	invalidateSnapshots();
+	return allocSnapshots();
+}
+
+void RunAheadManager::invalidateSnapshots()
+{
+	snapshotIsPrimed = false;
+	ringHead = ringCount = 0;
+	inputChanged.store(false, std::memory_order_relaxed);
+}
+
+bool RunAheadManager::allocSnapshots()
+{
+	if(!frames_ || !stateSize)
+		return true;
+	try
+	{
+		for(auto i : iotaCount(snapshots.size()))
+		{
+			auto &s = snapshots[i];
+			if(i >= size_t(snapshotCount()))
+				s = {};
+			else if(!s.size())
+				s.resetForOverwrite(stateSize);
+		}
+		log.info("allocated {} snapshot(s) of size:{}", snapshotCount(), stateSize);
+		return true;
+	}
+	catch(...)
+	{
+		snapshots = {};
+		return false;
+	}
+}
+
+void RunAheadManager::setFrames(int8_t frames)
+{
+	frames_ = frames;
+	invalidateSnapshots();
+	if(!frames_)
+		snapshots = {};
+	allocSnapshots();
+}
+
+void RunAheadManager::setMode(RunAheadMode mode)
+{
+	mode_ = mode;
+	invalidateSnapshots();
+	allocSnapshots();
+}
+
+void RunAheadManager::runFrames(EmuSystemTaskContext taskCtx, EmuApp &app, EmuVideo *video, EmuAudio *audio, int frames)
+{
+	if(!frames_ || !snapshots[snapshotCount() - 1].size())
+	{
+		app.system().runFrames(taskCtx, video, audio, frames);
+		return;
+	}
+	if(mode_ == RunAheadMode::Preemptive)
+		runFramesPreemptive(taskCtx, app, video, audio, frames);
+	else
+		runFramesAhead(taskCtx, app, video, audio, frames);
+}
+
+void RunAheadManager::runFramesAhead(EmuSystemTaskContext taskCtx, EmuApp &app, EmuVideo *video, EmuAudio *audio, int frames)
+{
+	auto &sys = app.system();
+	if(!video)
+	{
+		sys.runFrames(taskCtx, video, audio, frames);
+		return;
+	}
+	auto &snapshot = snapshots[0];
+	// advance the real state, then emulate ahead with audio muted and present the last frame
+	sys.skipFrames(taskCtx, frames, audio);
+	// the first write into the buffer can't be incremental since it holds no previous state
+	auto size = sys.writeState(snapshot, {.uncompressed = true, .incremental = snapshotIsPrimed});
+	snapshotIsPrimed = true;
+	sys.skipFrames(taskCtx, frames_ - 1, nullptr);
+	sys.runFrame(taskCtx, video, nullptr);
+	try
+	{
+		sys.readState(app, {snapshot.data(), size});
+	}
+	catch(std::exception &err)
+	{
+		log.error("error restoring state:{}, disabling run-ahead", err.what());
+		frames_ = 0;
+	}
+	sys.updateBackupMemoryCounter();
+}
+
+void RunAheadManager::runFramesPreemptive(EmuSystemTaskContext taskCtx, EmuApp &app, EmuVideo *video, EmuAudio *audio, int frames)
+{
+	auto &sys = app.system();
+	// input is predicted to stay the same, so frames only need to be re-emulated
+	// when it changes, as if the change had been polled frames_ frames earlier
+	if(inputChanged.exchange(false, std::memory_order_relaxed) && !rollback(taskCtx, app))
+	{
+		sys.runFrames(taskCtx, video, audio, frames);
+		return;
+	}
+	for(auto i : iotaCount(frames))
+	{
+		pushSnapshot(sys);
+		sys.runFrame(taskCtx, i == frames - 1 ? video : nullptr, audio);
+	}
+	sys.updateBackupMemoryCounter();
+}
+
+void RunAheadManager::pushSnapshot(EmuSystem &sys)
+{
+	// incremental writes can't be used since each slot holds a different older state
+	snapshotSizes[ringHead] = sys.writeState(snapshots[ringHead], {.uncompressed = true});
+	ringHead = (ringHead + 1) % frames_;
+	ringCount = std::min(int8_t(ringCount + 1), frames_);
+}
+
+bool RunAheadManager::rollback(EmuSystemTaskContext taskCtx, EmuApp &app)
+{
+	if(!ringCount)
+		return true;
+	auto &sys = app.system();
+	// the oldest snapshot is at the head when the ring is full, otherwise at the start
+	auto oldest = ringCount == frames_ ? ringHead : int8_t{};
+	auto replayFrames = ringCount;
+	try
+	{
+		sys.readState(app, {snapshots[oldest].data(), snapshotSizes[oldest]});
+	}
+	catch(std::exception &err)
+	{
+		log.error("error restoring state:{}, disabling run-ahead", err.what());
+		frames_ = 0;
+		return false;
+	}
+	// re-emulate with the new input, the audio of these frames was already output
+	ringHead = ringCount = 0;
+	for([[maybe_unused]] auto i : iotaCount(replayFrames))
+	{
+		pushSnapshot(sys);
+		sys.runFrame(taskCtx, nullptr, nullptr);
+	}
+	return true;
+}
+
+bool RunAheadManager::readConfig(MapIO &io, unsigned key)
+{
+	switch(key)
+	{
+		default: return false;
+		case CFGKEY_RUN_AHEAD_FRAMES: return readOptionValue(io, frames_, [](auto f){ return f >= 0 && f <= maxRunAheadFrames; });
+		case CFGKEY_RUN_AHEAD_MODE: return readOptionValue(io, mode_, [](auto m){ return m <= lastEnum<RunAheadMode>; });
+	}
+}
+
+void RunAheadManager::writeConfig(FileIO &io) const
+{
+	writeOptionValueIfNotDefault(io, CFGKEY_RUN_AHEAD_FRAMES, frames_, int8_t{});
+	writeOptionValueIfNotDefault(io, CFGKEY_RUN_AHEAD_MODE, mode_, RunAheadMode::Full);
+}
+
+}
@@ -0,0 +1,23 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+// Builds the Speex resampler bundled with the Mednafen sources for use by EmuAudio,
+// the symbols use their own prefix so apps can also link mednafen_common's copy
+
+#ifdef __x86_64__
+#define ARCH_X86_64
+#endif
+#define RANDOM_PREFIX EmuEx
+#include "shared/mednafen/resampler/resample.c"
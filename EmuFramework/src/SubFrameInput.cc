@@ -0,0 +1,85 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/SubFrameInput.hh>
+#include <emuframework/EmuApp.hh>
+import imagine;
+
+namespace EmuEx
+{
+
+void SubFrameInput::beginFrame(EmuApp &app, SteadyClockTimePoint startTime, SteadyClockDuration duration)
+{
+	appPtr = &app;
+	frameStartTime = startTime;
+	frameDuration = duration;
+}
+
+void SubFrameInput::endFrame(EmuApp &app)
+{
+	appPtr = {};
+	if(actions.empty())
+		return;
+	applyUntil(app, SteadyClockTimePoint::max());
+	// anything left is the release of a tap pressed in this frame
+	actions.erase(actions.begin(), actions.begin() + appliedActions);
+	appliedActions = 0;
+}
+
+bool SubFrameInput::queue(InputAction action, SteadyClockTimePoint time)
+{
+	if(actions.isFull()) [[unlikely]]
+		return false;
+	actions.emplace_back(action, time);
+	return true;
+}
+
+void SubFrameInput::clear()
+{
+	actions.clear();
+	appliedActions = 0;
+}
+
+bool SubFrameInput::applyQueued(float framePos)
+{
+	auto &app = *appPtr;
+	app.appContext().dispatchQueuedInputEvents();
+	if(appliedActions == actions.size())
+		return false;
+	auto emulatedTime = frameStartTime + std::chrono::duration_cast<SteadyClockDuration>(frameDuration * framePos);
+	return applyUntil(app, emulatedTime);
+}
+
+bool SubFrameInput::applyUntil(EmuApp &app, SteadyClockTimePoint time)
+{
+	auto firstAction = appliedActions;
+	for(; appliedActions < actions.size(); appliedActions++)
+	{
+		auto &queued = actions[appliedActions];
+		if(queued.time > time)
+			break;
+		auto &a = queued.action;
+		// hold back a release pressed in the same poll so the game still sees taps shorter than its polling interval
+		if(!a.isPushed() && std::ranges::any_of(std::span{&actions[firstAction], appliedActions - firstAction},
+			[&](auto &prev){ return prev.action.isPushed() && prev.action.code == a.code && prev.action.flags.deviceId == a.flags.deviceId; }))
+		{
+			break;
+		}
+		app.system().handleInputAction(&app, a);
+	}
+	return appliedActions != firstAction;
+}
+
+}
@@ -104,6 +104,15 @@ AudioOptionView::AudioOptionView(ViewAttachParams attach, EmuAudio& audio_, bool
 			audio.addSoundBuffersOnUnderrunSetting = item.flipBoolValue(*this);
 		}
 	},
+	rateControl
+	{
+		"Dynamic Rate Control", attach,
+		audio_.rateControl(),
+		[this](BoolMenuItem &item)
+		{
+			audio.setRateControl(item.flipBoolValue(*this));
+		}
+	},
 	audioRateItem
 	{
 		[&]
@@ -186,6 +195,7 @@ void AudioOptionView::loadStockItems()
 	}
 	item.emplace_back(&soundBuffers);
 	item.emplace_back(&addSoundBuffersOnUnderrun);
+	item.emplace_back(&rateControl);
 	if constexpr(Audio::Manager::HAS_SOLO_MIX)
 	{
 		item.emplace_back(&audioSoloMix);
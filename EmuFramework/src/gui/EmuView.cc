@@ -110,7 +110,7 @@ void EmuView::setShowFrameTimingStats(bool on)
 
 void EmuView::setShowAudioStats(bool on)
 {
-	showFrameTimingStats = on;
+	showAudioStats = on;
 	updateShowStats();
 }
 
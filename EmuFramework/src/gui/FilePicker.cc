@@ -52,6 +52,10 @@ FilePicker::FilePicker(ViewAttachParams attach, EmuApp &app,
 {
 	if(app.showHiddenFilesInPicker)
 		setShowHiddenFiles(true);
+	setListDirectory([&app](CStringView path, DirectoryEntryDelegate onEntry)
+	{
+		app.contentIndex.forEachInDirectory(app.appContext(), path, onEntry);
+	});
 }
 
 std::unique_ptr<FilePicker> FilePicker::forBenchmarking(ViewAttachParams attach, const Input::Event &e, bool singleDir)
@@ -130,6 +130,33 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 		app().showFrameTimingStats,
 		[this](BoolMenuItem &item) { app().showFrameTimingStats = item.flipBoolValue(*this); }
 	},
+	recordFrameTrace
+	{
+		"Record Frame Trace", attach,
+		app().frameTrace.isEnabled(),
+		[this](BoolMenuItem &item) { app().frameTrace.setEnabled(item.flipBoolValue(*this)); }
+	},
+	exportFrameTrace
+	{
+		"Export Frame Trace", attach,
+		[this]
+		{
+			try
+			{
+				auto dir = FS::createDirectorySegments(appContext().storagePath(), "EmuEx");
+				auto jsonPath = FS::pathString(dir, "frameTrace.json");
+				FileIO jsonFile{jsonPath, OpenFlags::newFile()};
+				app().frameTrace.writeChromeTrace(jsonFile);
+				FileIO csvFile{FS::pathString(dir, "frameTrace.csv"), OpenFlags::newFile()};
+				app().frameTrace.writeCSV(csvFile);
+				app().postMessage(4, false, std::format("Wrote frame trace to:\n{}", jsonPath));
+			}
+			catch(std::exception &err)
+			{
+				app().postErrorMessage(err.what());
+			}
+		}
+	},
 	lowLatencyVideo
 	{
 		"Low Latency Mode", attach,
@@ -266,6 +293,8 @@ void FrameTimingView::loadStockItems()
 	if(app().emuWindow().supportsFrameClockSource(FrameClockSource::Screen))
 		item.emplace_back(&outputRateMode);
 	item.emplace_back(&frameTimingStats);
+	item.emplace_back(&recordFrameTrace);
+	item.emplace_back(&exportFrameTrace);
 	item.emplace_back(&advancedHeading);
 	item.emplace_back(&frameClock);
 	if(used(presentMode))
@@ -42,6 +42,8 @@ protected:
 	MultiChoiceMenuItem frameRate;
 	MultiChoiceMenuItem frameRatePAL;
 	BoolMenuItem frameTimingStats;
+	BoolMenuItem recordFrameTrace;
+	TextMenuItem exportFrameTrace;
 	BoolMenuItem lowLatencyVideo;
 	StaticArrayList<TextMenuItem, maxFrameClockItems> frameClockItems;
 	MultiChoiceMenuItem frameClock;
@@ -53,7 +55,7 @@ protected:
 	ConditionalMember<Config::multipleScreenFrameRates, MultiChoiceMenuItem> screenFrameRate;
 	BoolMenuItem blankFrameInsertion;
 	TextHeadingMenuItem advancedHeading;
-	StaticArrayList<MenuItem*, 11> item;
+	StaticArrayList<MenuItem*, 13> item;
 
 	bool onFrameRateChange(VideoSystem, SteadyClockDuration);
 };
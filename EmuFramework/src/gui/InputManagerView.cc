@@ -285,6 +285,15 @@ InputManagerOptionsView::InputManagerOptionsView(ViewAttachParams attach):
 			app().notifyOnInputDeviceChange = item.flipBoolValue(*this);
 		}
 	},
+	inputThread
+	{
+		"Read Gamepads On Input Thread", attach,
+		appContext().hasInputThread(),
+		[this](BoolMenuItem &item)
+		{
+			appContext().setInputThread(item.flipBoolValue(*this));
+		}
+	},
 	bluetoothHeading
 	{
 		"In-app Bluetooth Options", attach,
@@ -350,6 +359,10 @@ InputManagerOptionsView::InputManagerOptionsView(ViewAttachParams attach):
 	{
 		item.emplace_back(&notifyDeviceChange);
 	}
+	if(used(inputThread))
+	{
+		item.emplace_back(&inputThread);
+	}
 	if(used(bluetoothHeading))
 	{
 		item.emplace_back(&bluetoothHeading);
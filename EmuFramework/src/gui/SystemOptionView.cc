@@ -22,6 +22,13 @@ import imagine;
 namespace EmuEx
 {
 
+static std::string rewindFrameIntervalName(int frames)
+{
+	if(!frames)
+		return "Off";
+	return std::to_string(frames);
+}
+
 SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 	TableView{"System Options", attach, item},
 	autosaveTimerItem
@@ -173,6 +180,60 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			.defaultItemOnSelect = [this](TextMenuItem &item) { app().setAltSpeed(AltSpeedMode::slow, item.id); }
 		},
 	},
+	runAheadFramesItem
+	{
+		{"Off", attach, {.id = 0}},
+		{"1",   attach, {.id = 1}},
+		{"2",   attach, {.id = 2}},
+		{"3",   attach, {.id = 3}},
+		{"4",   attach, {.id = 4}},
+	},
+	runAheadFrames
+	{
+		"Run-ahead Frames", attach,
+		MenuId{app().runAheadManager.frames()},
+		runAheadFramesItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item)
+			{
+				auto suspendCtx = app().suspendEmulationThread();
+				app().runAheadManager.setFrames(item.id);
+			}
+		},
+	},
+	runAheadMode
+	{
+		"Run-ahead Mode", attach,
+		app().runAheadManager.mode() == RunAheadMode::Preemptive,
+		"Full", "Preemptive",
+		[this](BoolMenuItem &item)
+		{
+			auto suspendCtx = app().suspendEmulationThread();
+			app().runAheadManager.setMode(item.flipBoolValue(*this) ? RunAheadMode::Preemptive : RunAheadMode::Full);
+		}
+	},
+	archiveCacheSizeItem
+	{
+		{"Off",   attach, {.id = 0}},
+		{"512MB", attach, {.id = 512}},
+		{"1GB",   attach, {.id = 1024}},
+		{"2GB",   attach, {.id = 2048}},
+		{"4GB",   attach, {.id = 4096}},
+	},
+	archiveCacheSize
+	{
+		"Archive Cache Size", attach,
+		MenuId{app().archiveContentCache.maxMiB()},
+		archiveCacheSizeItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item)
+			{
+				app().archiveContentCache.setMaxMiB(item.id);
+				if(!item.id)
+					app().archiveContentCache.clear(appContext());
+			}
+		},
+	},
 	rewindStatesItem
 	{
 		{"0",  attach, {.id = 0}},
@@ -226,6 +287,31 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 				});
 		}
 	},
+	rewindFrameInterval
+	{
+		"State Interval (Frames)", rewindFrameIntervalName(app().rewindManager.frameInterval()), attach,
+		[this](const Input::Event &e)
+		{
+			pushAndShowNewCollectValueRangeInputView<int, 0, maxRewindFrameInterval>(attachParams(), e,
+				"Input 0 to 60 (0 to use seconds)", std::to_string(app().rewindManager.frameInterval()),
+				[this](CollectTextInputView &, auto val)
+				{
+					app().rewindManager.setFrameInterval(val);
+					rewindFrameInterval.set2ndName(rewindFrameIntervalName(val));
+					return true;
+				});
+		}
+	},
+	rewindStorageMode
+	{
+		"State Storage", attach,
+		app().rewindManager.storageMode() == RewindStorageMode::Delta,
+		"Full", "Delta",
+		[this](BoolMenuItem &item)
+		{
+			app().rewindManager.setStorageMode(item.flipBoolValue(*this) ? RewindStorageMode::Delta : RewindStorageMode::Full);
+		}
+	},
 	performanceMode
 	{
 		"Performance Mode", attach,
@@ -272,10 +358,15 @@ void SystemOptionView::loadStockItems()
 	item.emplace_back(&rewindHeading);
 	item.emplace_back(&rewindStates);
 	item.emplace_back(&rewindTimeInterval);
+	item.emplace_back(&rewindFrameInterval);
+	item.emplace_back(&rewindStorageMode);
 	item.emplace_back(&otherHeading);
 	item.emplace_back(&confirmOverwriteState);
 	item.emplace_back(&fastModeSpeed);
 	item.emplace_back(&slowModeSpeed);
+	item.emplace_back(&runAheadFrames);
+	item.emplace_back(&runAheadMode);
+	item.emplace_back(&archiveCacheSize);
 	if(used(performanceMode) && appContext().hasSustainedPerformanceMode())
 		item.emplace_back(&performanceMode);
 	if(used(noopThread))
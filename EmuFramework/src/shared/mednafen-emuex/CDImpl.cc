@@ -113,6 +113,55 @@ static int readSector(auto &cdAccess, uint8 *buf, int32 lba, uint32 size)
 
 int CDAccess_Image::Read_Sector(uint8 *buf, int32 lba, uint32 size)
 {
+	// Copy the requested part of a binary track sector straight from the image stream,
+	// which is memory mapped for uncompressed files, skipping the raw sector buffer and
+	// the header/EDC/ECC synthesis Read_Raw_Sector() does for ISO & MODE2 tracks
+	if(lba < total_sectors)
+	{
+		for(int32 track = FirstTrack; track < (FirstTrack + NumTracks); track++)
+		{
+			CDRFILE_TRACK_INFO *ct = &Tracks[track];
+
+			if(lba < (ct->LBA - ct->pregap_dv - ct->pregap) || lba >= (ct->LBA + ct->sectors + ct->postgap))
+				continue;
+			if(lba < (ct->LBA - ct->pregap_dv) || lba >= (ct->LBA + ct->sectors) || ct->AReader)
+				break;
+
+			uint32 dataOffset{};
+			switch(ct->DIFormat)
+			{
+				case DI_FORMAT_AUDIO:
+					if(ct->RawAudioMSBFirst)
+						return readSector(*this, buf, lba, size);
+					break;
+				case DI_FORMAT_MODE1_RAW:
+				case DI_FORMAT_MODE2_RAW:
+					dataOffset = 16;
+					break;
+				case DI_FORMAT_MODE1:
+				case DI_FORMAT_MODE2:
+				case DI_FORMAT_CDI_RAW:
+					break;
+				default:
+					return readSector(*this, buf, lba, size);
+			}
+			if(dataOffset + size > uint32(DI_Size_Table[ct->DIFormat]))
+				break;
+
+			long SeekPos = ct->FileOffset;
+			long LBARelPos = lba - ct->LBA;
+
+			SeekPos += LBARelPos * DI_Size_Table[ct->DIFormat];
+
+			if(ct->SubchannelMode)
+			 SeekPos += 96 * (lba - ct->LBA);
+
+			auto bytes = std::max(int64(ct->fp->readAtPos(buf, size, SeekPos + dataOffset)), int64{});
+			if(bytes < size)
+				memset(buf + bytes, 0, size - bytes);
+			return ct->DIFormat;
+		}
+	}
 	return readSector(*this, buf, lba, size);
 }
 
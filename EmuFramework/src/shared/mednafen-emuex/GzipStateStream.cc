@@ -0,0 +1,289 @@
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include "GzipStateStream.hh"
+#include <mednafen/mednafen.h>
+import imagine;
+
+namespace Mednafen
+{
+
+using namespace IG;
+
+constexpr size_t outBuffSize = 0x10000;
+constexpr size_t inBuffSize = 0x10000;
+constexpr uint64 maxZlibChunk = 0x40000000;
+
+static uint64 seekTarget(int64 offset, int whence, uint64 pos, uint64 size)
+{
+	switch(whence)
+	{
+		case SEEK_SET: return offset;
+		case SEEK_CUR: return pos + offset;
+		case SEEK_END: return size + offset;
+	}
+	throw MDFN_Error(ErrnoHolder(EINVAL));
+}
+
+uint64 StatePatchScanStream::read(void *, uint64, bool)
+{
+	throw MDFN_Error(0, _("Stream is write-only"));
+}
+
+void StatePatchScanStream::write(const void *data, uint64 count)
+{
+	if(pos >= endPos)
+	{
+		pos += count;
+		endPos = pos;
+		return;
+	}
+	if(pos + count > endPos || count > Patch{}.data.size())
+		throw MDFN_Error(0, _("Unsupported overwrite of %llu bytes at %llu in state stream"),
+			(unsigned long long)count, (unsigned long long)pos);
+	auto it = std::ranges::find_if(patches, [&](const auto &p){ return p.pos == pos && p.size == count; });
+	auto &patch = it != patches.end() ? *it : patches.emplace_back(pos, std::array<uint8, 8>{}, uint8(count));
+	memcpy(patch.data.data(), data, count);
+	pos += count;
+}
+
+void StatePatchScanStream::truncate(uint64 length)
+{
+	endPos = length;
+}
+
+void StatePatchScanStream::seek(int64 offset, int whence)
+{
+	pos = seekTarget(offset, whence, pos, endPos);
+}
+
+std::vector<StatePatchScanStream::Patch> StatePatchScanStream::takePatches()
+{
+	std::ranges::sort(patches, {}, &Patch::pos);
+	for(size_t i = 1; i < patches.size(); i++)
+	{
+		if(patches[i - 1].pos + patches[i - 1].size > patches[i].pos)
+			throw MDFN_Error(0, _("Overlapping writes in state stream"));
+	}
+	return std::move(patches);
+}
+
+GzipWriteStream::GzipWriteStream(IO &io, int level, std::vector<StatePatchScanStream::Patch> patches):
+	io{io}, patches{std::move(patches)}, outBuff{std::make_unique_for_overwrite<uint8[]>(outBuffSize)}
+{
+	if(deflateInit2(&zs, level, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		throw MDFN_Error(0, _("Error initializing zlib deflate"));
+}
+
+GzipWriteStream::~GzipWriteStream()
+{
+	deflateEnd(&zs);
+}
+
+uint64 GzipWriteStream::read(void *, uint64, bool)
+{
+	throw MDFN_Error(0, _("Stream is write-only"));
+}
+
+void GzipWriteStream::write(const void *data, uint64 count)
+{
+	if(finished)
+		throw MDFN_Error(0, _("Write to closed stream"));
+	if(pos < endPos)
+	{
+		// already emitted with the patched value from the scan pass
+		if(pos + count > endPos)
+			throw MDFN_Error(0, _("Unsupported overwrite of %llu bytes at %llu in compressed stream"),
+				(unsigned long long)count, (unsigned long long)pos);
+		pos += count;
+		return;
+	}
+	if(pos > endPos) // fill the gap left by a seek past the end with zeros like MemoryStream
+	{
+		static constexpr std::array<uint8, 256> zeros{};
+		auto gapEnd = std::exchange(pos, endPos);
+		while(pos < gapEnd)
+		{
+			append(zeros.data(), std::min<uint64>(zeros.size(), gapEnd - pos));
+		}
+	}
+	append(static_cast<const uint8*>(data), count);
+}
+
+void GzipWriteStream::append(const uint8 *data, uint64 count)
+{
+	const auto end = pos + count;
+	while(pos < end)
+	{
+		while(nextPatch < patches.size() && patches[nextPatch].pos + patches[nextPatch].size <= pos)
+			nextPatch++;
+		if(nextPatch == patches.size() || patches[nextPatch].pos >= end)
+		{
+			compress(data + (count - (end - pos)), end - pos);
+			pos = end;
+			break;
+		}
+		auto &patch = patches[nextPatch];
+		if(patch.pos > pos)
+		{
+			compress(data + (count - (end - pos)), patch.pos - pos);
+			pos = patch.pos;
+			continue;
+		}
+		auto patchOffset = pos - patch.pos;
+		auto patchBytes = std::min<uint64>(patch.size - patchOffset, end - pos);
+		compress(patch.data.data() + patchOffset, patchBytes);
+		pos += patchBytes;
+	}
+	endPos = pos;
+}
+
+void GzipWriteStream::compress(const uint8 *data, uint64 count, int flush)
+{
+	do
+	{
+		auto chunk = std::min(count, maxZlibChunk);
+		zs.next_in = const_cast<Bytef*>(data);
+		zs.avail_in = chunk;
+		data += chunk;
+		count -= chunk;
+		auto chunkFlush = count ? Z_NO_FLUSH : flush;
+		do
+		{
+			zs.next_out = outBuff.get();
+			zs.avail_out = outBuffSize;
+			if(deflate(&zs, chunkFlush) == Z_STREAM_ERROR)
+				throw MDFN_Error(0, _("Error compressing state"));
+			auto outBytes = outBuffSize - zs.avail_out;
+			if(outBytes && io.write(outBuff.get(), outBytes) != ssize_t(outBytes))
+			{
+				ErrnoHolder ene(errno);
+				throw MDFN_Error(ene.Errno(), _("Error writing to opened file"));
+			}
+		} while(zs.avail_out == 0);
+	} while(count);
+}
+
+void GzipWriteStream::truncate(uint64)
+{
+	throw MDFN_Error(0, _("Compressed stream can't be truncated"));
+}
+
+void GzipWriteStream::seek(int64 offset, int whence)
+{
+	pos = seekTarget(offset, whence, pos, size());
+}
+
+void GzipWriteStream::close()
+{
+	if(finished)
+		return;
+	compress(nullptr, 0, Z_FINISH);
+	finished = true;
+}
+
+GzipReadStream::GzipReadStream(IO &io):
+	io{io}, startOffset{io.tell()}, inBuff{std::make_unique_for_overwrite<uint8[]>(inBuffSize)}
+{
+	if(inflateInit2(&zs, MAX_WBITS + 16) != Z_OK)
+		throw MDFN_Error(0, _("Error initializing zlib inflate"));
+}
+
+GzipReadStream::~GzipReadStream()
+{
+	inflateEnd(&zs);
+}
+
+uint64 GzipReadStream::read(void *data, uint64 count, bool error_on_eos)
+{
+	auto bytes = decompress(static_cast<uint8*>(data), count);
+	if(bytes != count && error_on_eos)
+		throw MDFN_Error(0, _("Unexpected EOF while reading from compressed file"));
+	return bytes;
+}
+
+void GzipReadStream::write(const void *, uint64)
+{
+	throw MDFN_Error(0, _("Stream is read-only"));
+}
+
+void GzipReadStream::truncate(uint64)
+{
+	throw MDFN_Error(0, _("Stream is read-only"));
+}
+
+void GzipReadStream::seek(int64 offset, int whence)
+{
+	auto target = seekTarget(offset, whence, pos, whence == SEEK_END ? size() : 0);
+	if(target < pos)
+		restart();
+	auto skipBytes = target - pos;
+	if(decompress(nullptr, skipBytes) != skipBytes)
+		throw MDFN_Error(0, _("Seek past end of compressed file"));
+}
+
+uint64 GzipReadStream::size()
+{
+	// uncompressed size modulo 2^32 from the gzip trailer
+	uint8 trailer[4];
+	auto ioSize = io.size();
+	if(ioSize < 18 || io.read(trailer, sizeof(trailer), ioSize - sizeof(trailer)) != sizeof(trailer))
+		throw MDFN_Error(0, _("Invalid compressed file size"));
+	return MDFN_de32lsb(trailer);
+}
+
+void GzipReadStream::restart()
+{
+	if(inflateReset(&zs) != Z_OK || io.seek(startOffset, IOSeekMode::Set) == -1)
+		throw MDFN_Error(0, _("Error restarting decompression"));
+	zs.avail_in = 0;
+	pos = 0;
+	streamEnd = false;
+}
+
+uint64 GzipReadStream::decompress(uint8 *dest, uint64 count)
+{
+	std::array<uint8, 0x1000> discardBuff;
+	uint64 total{};
+	while(total < count && !streamEnd)
+	{
+		if(!zs.avail_in)
+		{
+			auto bytes = io.read(inBuff.get(), inBuffSize);
+			if(bytes == -1)
+			{
+				ErrnoHolder ene(errno);
+				throw MDFN_Error(ene.Errno(), _("Error reading from opened file"));
+			}
+			if(!bytes)
+				break;
+			zs.next_in = inBuff.get();
+			zs.avail_in = bytes;
+		}
+		auto outSize = dest ? std::min(count - total, maxZlibChunk) : std::min<uint64>(count - total, discardBuff.size());
+		zs.next_out = dest ? dest + total : discardBuff.data();
+		zs.avail_out = outSize;
+		auto res = inflate(&zs, Z_NO_FLUSH);
+		total += outSize - zs.avail_out;
+		if(res == Z_STREAM_END)
+			streamEnd = true;
+		else if(res != Z_OK && res != Z_BUF_ERROR)
+			throw MDFN_Error(0, _("Error uncompressing state: %s"), zs.msg ? zs.msg : "unknown error");
+	}
+	pos += total;
+	return total;
+}
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <mednafen/Stream.h>
+#include <zlib.h>
+#ifdef IG_USE_MODULES
+import imagine;
+import std;
+#else
+#include <imagine/io/IO.hh>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+#endif
+
+namespace Mednafen
+{
+
+// Write-only stream that discards data and only tracks positions, recording any
+// write to data that was already written, like the section sizes MDFNSS_SaveSM
+// fills in after the section data
+class StatePatchScanStream final : public Stream
+{
+public:
+	struct Patch
+	{
+		uint64 pos{};
+		std::array<uint8, 8> data{};
+		uint8 size{};
+	};
+
+	uint64 attributes() final { return ATTRIBUTE_WRITEABLE | ATTRIBUTE_SEEKABLE; }
+	uint64 read(void *data, uint64 count, bool error_on_eos = true) final;
+	void write(const void *data, uint64 count) final;
+	void truncate(uint64 length) final;
+	void seek(int64 offset, int whence) final;
+	uint64 tell() final { return pos; }
+	uint64 size() final { return endPos; }
+	void flush() final {}
+	void close() final {}
+	std::vector<Patch> takePatches();
+
+private:
+	std::vector<Patch> patches;
+	uint64 pos{};
+	uint64 endPos{};
+};
+
+// Write-only stream that gzip compresses into an IO through a fixed size output window.
+// Data is only ever appended, so writes to previously written positions must have been
+// recorded in an earlier StatePatchScanStream pass and get applied when the data is first written
+class GzipWriteStream final : public Stream
+{
+public:
+	GzipWriteStream(IG::IO &, int level, std::vector<StatePatchScanStream::Patch> patches = {});
+	~GzipWriteStream() final;
+	uint64 attributes() final { return ATTRIBUTE_WRITEABLE | ATTRIBUTE_SEEKABLE | ATTRIBUTE_SLOW_SEEK; }
+	uint64 read(void *data, uint64 count, bool error_on_eos = true) final;
+	void write(const void *data, uint64 count) final;
+	void truncate(uint64 length) final;
+	void seek(int64 offset, int whence) final;
+	uint64 tell() final { return pos; }
+	uint64 size() final { return std::max(pos, endPos); }
+	void flush() final {}
+	void close() final;
+
+private:
+	IG::IO &io;
+	z_stream zs{};
+	std::vector<StatePatchScanStream::Patch> patches;
+	size_t nextPatch{};
+	uint64 pos{};
+	uint64 endPos{};
+	std::unique_ptr<uint8[]> outBuff;
+	bool finished{};
+
+	void append(const uint8 *data, uint64 count);
+	void compress(const uint8 *data, uint64 count, int flush = Z_NO_FLUSH);
+};
+
+// Read-only stream that inflates gzip data from an IO through a fixed size input window,
+// forward seeks decompress and discard data while backward seeks restart from the beginning
+class GzipReadStream final : public Stream
+{
+public:
+	GzipReadStream(IG::IO &);
+	~GzipReadStream() final;
+	uint64 attributes() final { return ATTRIBUTE_READABLE | ATTRIBUTE_SEEKABLE | ATTRIBUTE_SLOW_SEEK; }
+	uint64 read(void *data, uint64 count, bool error_on_eos = true) final;
+	void write(const void *data, uint64 count) final;
+	void truncate(uint64 length) final;
+	void seek(int64 offset, int whence) final;
+	uint64 tell() final { return pos; }
+	uint64 size() final;
+	void flush() final {}
+	void close() final {}
+
+private:
+	IG::IO &io;
+	z_stream zs{};
+	off_t startOffset{};
+	uint64 pos{};
+	std::unique_ptr<uint8[]> inBuff;
+	bool streamEnd{};
+
+	void restart();
+	uint64 decompress(uint8 *dest, uint64 count);
+};
+
+}
@@ -25,6 +25,7 @@
 #include <mednafen/FileStream.h>
 #include <mednafen/MemoryStream.h>
 #include <mednafen/cdrom/CDInterface.h>
+#include <mednafen-emuex/GzipStateStream.hh>
 #ifdef IG_USE_MODULES
 import imagine;
 import std;
@@ -145,8 +146,16 @@ inline void loadContent(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, IO &io,
 	mdfnGameInfo.Load(&gf);
 }
 
+struct RunFrameOptions
+{
+	size_t maxLineWidths{};
+	// Render into the locked video texture when the core always outputs the full surface at the origin
+	// and redraws all of it every frame, since a locked buffer's previous contents aren't preserved
+	bool renderToVideoImage{};
+};
+
 inline void runFrame(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, EmuSystemTaskContext taskCtx,
-	EmuVideo *videoPtr, MutablePixmapView pixView, EmuAudio *audioPtr, size_t maxAudioFrames, size_t maxLineWidths = 0)
+	EmuVideo *videoPtr, MutablePixmapView pixView, EmuAudio *audioPtr, size_t maxAudioFrames, RunFrameOptions opts = {})
 {
 	using namespace Mednafen;
 	int16 audioBuff[maxAudioFrames * 2];
@@ -160,12 +169,25 @@ inline void runFrame(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, EmuSystemTa
 	espec.sys = &sys;
 	espec.video = videoPtr;
 	espec.skip = !videoPtr;
+	EmuVideoImage videoImg;
+	if(videoPtr && opts.renderToVideoImage)
+	{
+		videoImg = videoPtr->startFrameWithFormat(taskCtx, pixView.desc());
+		if(videoImg)
+		{
+			assume(videoImg.pixmap().desc() == pixView.desc());
+			pixView = videoImg.pixmap();
+			espec.videoImg = &videoImg;
+		}
+	}
 	auto mSurface = toMDFNSurface(pixView);
 	espec.surface = &mSurface;
-	int32 lineWidth[maxLineWidths ?: 1];
-	if(maxLineWidths)
+	int32 lineWidth[opts.maxLineWidths ?: 1];
+	if(opts.maxLineWidths)
 		espec.LineWidths = lineWidth;
 	mdfnGameInfo.Emulate(&espec);
+	if(espec.videoImg) [[unlikely]] // core returned without committing, release the texture without presenting the partial frame
+		espec.videoImg->cancelFrame();
 	if(audioPtr)
 	{
 		assume((unsigned)espec.SoundBufSize <= audioPtr->format().bytesToFrames(sizeof(audioBuff)));
@@ -173,6 +195,20 @@ inline void runFrame(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, EmuSystemTa
 	}
 }
 
+inline void commitVideoFrame(Mednafen::EmulateSpecStruct &espec, MutablePixmapView surfacePix)
+{
+	if(espec.videoImg)
+	{
+		std::exchange(espec.videoImg, nullptr)->endFrame();
+		// any drawing after the commit goes to the private buffer since the texture is no longer locked
+		*espec.surface = toMDFNSurface(surfacePix);
+	}
+	else
+	{
+		espec.video->startFrameWithFormat(espec.taskCtx, surfacePix);
+	}
+}
+
 // Save states
 
 inline size_t stateSizeMDFN()
@@ -224,6 +260,43 @@ inline size_t writeStateMDFN(std::span<uint8_t> buff, SaveStateFlags flags)
 	}
 }
 
+// Streaming variants used when saving/loading state files, these never hold the complete
+// state in memory, at the cost of running the save code twice to find the section sizes
+// and re-inflating from the start when loading seeks backwards
+inline void readStateStreamMDFN(IO &io)
+{
+	using namespace Mednafen;
+	std::array<uint8_t, 16> header{};
+	auto headerBytes = io.read(header.data(), header.size(), io.tell());
+	if(!hasGzipHeader({header.data(), size_t(std::max(headerBytes, ssize_t{}))}))
+	{
+		readStateMDFN(io.buffer(IOBufferMode::Release));
+		return;
+	}
+	GzipReadStream s{io};
+	auto size = s.size();
+	if(size <= 32)
+		throw std::runtime_error("Invalid state size");
+	std::array<uint8_t, 32> stateHeader;
+	if(s.read(stateHeader.data(), stateHeader.size(), false) != stateHeader.size())
+		throw std::runtime_error("Error uncompressing state");
+	auto sizeFromHeader = MDFN_de32lsb(stateHeader.data() + 16 + 4) & 0x7FFFFFFF;
+	if(sizeFromHeader != size)
+		throw std::runtime_error(std::format("Bad state header size, got {} but expected {}", sizeFromHeader, size));
+	s.seek(0, SEEK_SET);
+	MDFNSS_LoadSM(&s);
+}
+
+inline void writeStateStreamMDFN(IO &io)
+{
+	using namespace Mednafen;
+	StatePatchScanStream scan;
+	MDFNSS_SaveSM(&scan);
+	GzipWriteStream s{io, int(MDFN_GetSettingI("filesys.state_comp_level")), scan.takePatches()};
+	MDFNSS_SaveSM(&s);
+	s.close();
+}
+
 inline void writeCDMD5(Mednafen::MDFNGI &mdfnGameInfo, const auto &cdInterfaces)
 {
 	Mednafen::md5_context layout_md5;
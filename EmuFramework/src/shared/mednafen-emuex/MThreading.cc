@@ -26,9 +26,11 @@ using namespace IG;
 
 [[maybe_unused]] constexpr SystemLogger log{"MDFNThreading"};
 
-struct Thread : public std::thread
+struct Thread
 {
-	using thread::thread;
+	std::thread thread;
+	ThreadId id{};
+	int status{};
 };
 struct Mutex : public std::mutex {};
 struct Cond : public std::condition_variable {};
@@ -39,15 +41,31 @@ struct Sem : public counting_semaphore<0x80000>
 
 Thread* Thread_Create(int (*fn)(void *), void *data, const char* debug_name)
 {
-	return new Thread{fn, data};
+	auto thread = new Thread;
+	// wait for the thread ID so it's valid for thread groups as soon as this returns
+	thread->thread = makeThreadSync([=](auto &sem)
+	{
+		thread->id = thisThreadId();
+		sem.release();
+		thread->status = fn(data);
+	});
+	log.info("created thread:{} ({})", thread->id, debug_name ? debug_name : "unnamed");
+	return thread;
 }
 
 void Thread_Wait(Thread* thread, int* status)
 {
-	thread->join();
+	thread->thread.join();
+	if(status)
+		*status = thread->status;
 	delete thread;
 }
 
+uintptr_t Thread_ID(Thread* thread)
+{
+	return thread->id;
+}
+
 uint64 Thread_SetAffinity(Thread* thread, const uint64 mask)
 {
 	return 0;
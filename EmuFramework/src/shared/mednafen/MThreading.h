@@ -52,6 +52,7 @@ struct Sem;
 Thread* Thread_Create(int (*fn)(void *), void *data, const char* debug_name = nullptr);
 void Thread_Wait(Thread *thread, int *status);
 uintptr_t Thread_ID(void);
+uintptr_t Thread_ID(Thread* thread);	// ID of a created thread, valid as soon as Thread_Create() returns
 uint64 Thread_SetAffinity(Thread* thread, uint64 mask) MDFN_COLD;
 
 //
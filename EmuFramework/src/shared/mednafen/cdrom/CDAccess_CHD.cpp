@@ -84,7 +84,12 @@ void CDAccess_CHD::Load(VirtualFS* vfs, const std::string &path, bool image_memc
   /* allocate storage for sector reads */
   const chd_header *head = chd_get_header(chd);
   hunkmem = (uint8_t *)malloc(head->hunkbytes);
-  oldhunk = -1;
+  hunkbytes = head->hunkbytes;
+  num_hunks = head->totalhunks;
+  for (auto &entry : hunk_cache)
+    entry.data.reset(new uint8_t[hunkbytes]);
+  hunk_mutex = MThreading::Mutex_Create();
+  cache_mutex = MThreading::Mutex_Create();
 
   MDFN_printf("chd_load '%s' hunkbytes=%d\n", path.c_str(), head->hunkbytes);
 
@@ -209,10 +214,36 @@ void CDAccess_CHD::Load(VirtualFS* vfs, const std::string &path, bool image_memc
       assert(Tracks[x].index[i] >= 0);
     }
   }
+
+  /* decompress upcoming hunks in the background so sequential reads, like FMV
+     and streamed audio, don't stall the emulation thread on FLAC/LZMA hunks */
+  if (image_memcache)
+  {
+    ra_cond = MThreading::Cond_Create();
+    ra_thread = MThreading::Thread_Create(Read_Ahead_Thread_C, this, "MDFN CHD Read-Ahead");
+  }
 }
 
 CDAccess_CHD::~CDAccess_CHD()
 {
+  if (ra_thread)
+  {
+    MThreading::Mutex_Lock(cache_mutex);
+    ra_quit = true;
+    MThreading::Cond_Signal(ra_cond);
+    MThreading::Mutex_Unlock(cache_mutex);
+    MThreading::Thread_Wait(ra_thread, NULL);
+  }
+
+  if (ra_cond)
+    MThreading::Cond_Destroy(ra_cond);
+
+  if (cache_mutex)
+    MThreading::Mutex_Destroy(cache_mutex);
+
+  if (hunk_mutex)
+    MThreading::Mutex_Destroy(hunk_mutex);
+
   if (chd != NULL)
     chd_close(chd);
 
@@ -222,76 +253,178 @@ CDAccess_CHD::~CDAccess_CHD()
 
 bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
 {
-  const chd_header *head = chd_get_header(chd);
   int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
+  int sph = hunkbytes / (2352 + 96);
   int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
   int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
-  {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
-  }
+  return Read_Cached_Hunk(buf, hunknum, hunkofs * (2352 + 96), 2352);
+}
 
-  memcpy(buf, hunkmem + hunkofs * (2352 + 96), 2352);
+bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+{
+  int cad = lba - track->LBA + track->fileOffset;
+  int sph = hunkbytes / (2352 + 96);
+  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
+  int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
 
-  return err;
+  return Read_Cached_Hunk(buf + 16, hunknum, hunkofs * (2352 + 96), 2048);
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
 {
-  const chd_header *head = chd_get_header(chd);
   int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
+  int sph = hunkbytes / (2352 + 96);
   int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
   int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+  return Read_Cached_Hunk(buf + 16, hunknum, hunkofs * (2352 + 96), 2336);
+}
+
+CDAccess_CHD::HunkCacheEntry* CDAccess_CHD::Find_Cached_Hunk(int32_t hunknum)
+{
+  for (auto &entry : hunk_cache)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    if (entry.hunknum == hunknum)
+    {
+      entry.last_use = ++hunk_cache_use;
+      return &entry;
+    }
   }
+  return nullptr;
+}
 
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2048);
+void CDAccess_CHD::Insert_Cached_Hunk(int32_t hunknum, const uint8_t *data)
+{
+  HunkCacheEntry *lru = &hunk_cache[0];
 
-  return err;
+  for (auto &entry : hunk_cache)
+  {
+    if (entry.last_use < lru->last_use)
+      lru = &entry;
+  }
+  memcpy(lru->data.get(), data, hunkbytes);
+  lru->hunknum = hunknum;
+  lru->last_use = ++hunk_cache_use;
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+bool CDAccess_CHD::Read_Cached_Hunk(uint8_t *buf, int32_t hunknum, uint32_t offset, uint32_t size)
 {
-  const chd_header *head = chd_get_header(chd);
-  int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
-  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
-  int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
   int err = CHDERR_NONE;
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+  MThreading::Mutex_Lock(cache_mutex);
+  if (HunkCacheEntry *entry = Find_Cached_Hunk(hunknum))
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
+    memcpy(buf, entry->data.get() + offset, size);
+    MThreading::Mutex_Unlock(cache_mutex);
+  }
+  else
+  {
+    MThreading::Mutex_Unlock(cache_mutex);
+    MThreading::Mutex_Lock(hunk_mutex);
+    MThreading::Mutex_Lock(cache_mutex);
+    // the read-ahead thread may have decompressed it while waiting for hunk_mutex
+    if (HunkCacheEntry *entry = Find_Cached_Hunk(hunknum))
+    {
+      memcpy(buf, entry->data.get() + offset, size);
+      MThreading::Mutex_Unlock(cache_mutex);
+    }
     else
-      oldhunk = hunknum;
+    {
+      MThreading::Mutex_Unlock(cache_mutex);
+      err = chd_read(chd, hunknum, hunkmem);
+      if (err != CHDERR_NONE)
+      {
+        MDFN_printf("chd_read_sector failed hunk=%d error=%d\n", hunknum, err);
+        memset(buf, 0, size);
+      }
+      else
+      {
+        memcpy(buf, hunkmem + offset, size);
+        MThreading::Mutex_Lock(cache_mutex);
+        Insert_Cached_Hunk(hunknum, hunkmem);
+        MThreading::Mutex_Unlock(cache_mutex);
+      }
+    }
+    MThreading::Mutex_Unlock(hunk_mutex);
   }
 
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2336);
+  Start_Read_Ahead(hunknum + 1);
 
   return err;
 }
 
+int32_t CDAccess_CHD::LBA_To_Hunk(int32_t lba) const
+{
+  for (int32_t track = FirstTrack; track < (FirstTrack + NumTracks); track++)
+  {
+    const CHDFILE_TRACK_INFO *ct = &Tracks[track];
+
+    if (lba >= (ct->LBA - ct->pregap_dv) && lba < (ct->LBA + ct->sectors))
+      return (lba - ct->LBA + ct->fileOffset) / (hunkbytes / (2352 + 96));
+  }
+  return -1;
+}
+
+void CDAccess_CHD::Start_Read_Ahead(int32_t hunknum)
+{
+  if (!ra_thread || hunknum < 0)
+    return;
+
+  MThreading::Mutex_Lock(cache_mutex);
+  int32_t end = std::min(hunknum + ReadAheadHunks, num_hunks);
+  if (end != ra_end)
+  {
+    ra_next = hunknum;
+    ra_end = end;
+    MThreading::Cond_Signal(ra_cond);
+  }
+  MThreading::Mutex_Unlock(cache_mutex);
+}
+
+int CDAccess_CHD::Read_Ahead_Thread_C(void *data)
+{
+  return ((CDAccess_CHD *)data)->Read_Ahead_Thread();
+}
+
+int CDAccess_CHD::Read_Ahead_Thread(void)
+{
+  MThreading::Mutex_Lock(cache_mutex);
+  while (!ra_quit)
+  {
+    if (ra_next >= ra_end)
+    {
+      MThreading::Cond_Wait(ra_cond, cache_mutex);
+      continue;
+    }
+
+    int32_t hunknum = ra_next++;
+    if (Find_Cached_Hunk(hunknum))
+      continue;
+
+    MThreading::Mutex_Unlock(cache_mutex);
+    MThreading::Mutex_Lock(hunk_mutex);
+    MThreading::Mutex_Lock(cache_mutex);
+    if (!Find_Cached_Hunk(hunknum))
+    {
+      MThreading::Mutex_Unlock(cache_mutex);
+      bool ok = chd_read(chd, hunknum, hunkmem) == CHDERR_NONE;
+      MThreading::Mutex_Lock(cache_mutex);
+      if (ok)
+        Insert_Cached_Hunk(hunknum, hunkmem);
+    }
+    MThreading::Mutex_Unlock(hunk_mutex);
+  }
+  MThreading::Mutex_Unlock(cache_mutex);
+
+  return 0;
+}
+
+void CDAccess_CHD::HintReadSector(int32 lba, int32 count)
+{
+  Start_Read_Ahead(LBA_To_Hunk(lba));
+}
+
 int CDAccess_CHD::Read_Raw_Sector(uint8 *buf, int32 lba)
 {
   uint8_t SimuQ[0xC];
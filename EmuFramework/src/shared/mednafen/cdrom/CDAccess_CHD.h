@@ -21,6 +21,7 @@
 
 #include <mednafen/FileStream.h>
 #include <mednafen/MemoryStream.h>
+#include <mednafen/MThreading.h>
 
 #include "CDAccess.h"
 #include <libchdr/chd.h>
@@ -66,7 +67,7 @@ class CDAccess_CHD final : public CDAccess
 
  void Read_TOC(CDUtility::TOC *toc) final;
 
- void HintReadSector(int32 lba, int32 count) final {};
+ void HintReadSector(int32 lba, int32 count) final;
 
  int Read_Sector(uint8 *buf, int32 lba, uint32 size) final;
 
@@ -82,6 +83,13 @@ class CDAccess_CHD final : public CDAccess
   bool Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
   bool Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
 
+  // Copies sector data from a hunk, decompressing it into the cache on a miss
+  bool Read_Cached_Hunk(uint8_t *buf, int32_t hunknum, uint32_t offset, uint32_t size);
+  int32_t LBA_To_Hunk(int32_t lba) const;
+  void Start_Read_Ahead(int32_t hunknum);
+  int Read_Ahead_Thread(void);
+  static int Read_Ahead_Thread_C(void *data);
+
   int32_t NumTracks;
   int32_t FirstTrack;
   int32_t LastTrack;
@@ -96,11 +104,36 @@ class CDAccess_CHD final : public CDAccess
   //struct track tracks[DISC_MAX_TRACKS];
   int num_tracks;
 
-  chd_file *chd;
-  /* hunk data cache */
-  uint8_t *hunkmem;
-  /* last hunknum read */
-  int oldhunk;
+  chd_file *chd = nullptr;
+  /* decompression buffer, only used with hunk_mutex locked */
+  uint8_t *hunkmem = nullptr;
+
+  /* LRU cache of decompressed hunks, protected by cache_mutex */
+  struct HunkCacheEntry
+  {
+    std::unique_ptr<uint8_t[]> data;
+    int32_t hunknum = -1;
+    uint32_t last_use = 0;
+  };
+  static constexpr unsigned HunkCacheSize = 16;
+  static constexpr int32_t ReadAheadHunks = 4;
+  HunkCacheEntry hunk_cache[HunkCacheSize];
+  uint32_t hunk_cache_use = 0;
+  uint32_t hunkbytes = 0;
+  int32_t num_hunks = 0;
+
+  HunkCacheEntry* Find_Cached_Hunk(int32_t hunknum);
+  void Insert_Cached_Hunk(int32_t hunknum, const uint8_t *data);
+
+  /* read-ahead worker, only used when the image is cached in memory since
+     CDInterface_MT already reads ahead on its own thread otherwise */
+  MThreading::Thread* ra_thread = nullptr;
+  MThreading::Mutex* hunk_mutex = nullptr;
+  MThreading::Mutex* cache_mutex = nullptr;
+  MThreading::Cond* ra_cond = nullptr;
+  int32_t ra_next = 0;
+  int32_t ra_end = 0;
+  bool ra_quit = false;
 };
 
 }
@@ -18,6 +18,7 @@
 namespace EmuEx
 {
 class EmuVideo;
+class EmuVideoImage;
 class EmuAudio;
 class EmuSystem;
 }
@@ -415,6 +416,10 @@ struct EmulateSpecStruct
 	// Calls MDFND_commitVideoFrame upon drawing a frame if non-null. Set by the driver code.
 	EmuEx::EmuVideo *video{};
 
+	// Locked video image that surface points into when rendering directly to the texture, ended by
+	// MDFND_commitVideoFrame instead of copying the surface if non-null. Set by the driver code.
+	EmuEx::EmuVideoImage *videoImg{};
+
 	// Used in MDFN_MidSync to update audio
 	EmuEx::EmuAudio *audio{};
 
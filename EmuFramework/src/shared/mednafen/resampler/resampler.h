@@ -37,7 +37,9 @@
 
 /* Begin Mednafen modifications */
 
+#ifndef RANDOM_PREFIX
 #define RANDOM_PREFIX MDFN
+#endif
 
 #define OUTSIDE_SPEEX
 
@@ -191,7 +191,7 @@ void VController::toggleKeyboard()
 {
 	log.info("toggling keyboard");
 	resetInput();
-	kbMode ^= true;
+	kbMode = !kbMode;
 	system().onVKeyboardShown(kb, kbMode);
 }
 
@@ -3,6 +3,8 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
+#include <algorithm>
 
 #include "core/base/port.h"
 #include "core/gba/gbaGlobals.h"
@@ -125,102 +127,64 @@ static inline void gfxDrawTextScreen(uint8_t g_vram[0x20000], uint16_t control,
       screenBase += 0x400;
   }
 
+  // Decode a full tile row per map entry instead of re-fetching the map entry and
+  // tile data for every pixel, tiles are 8 pixel aligned so map wrapping only
+  // happens on a tile boundary
   int yshift = ((yyy >> 3) << 5);
-  if ((control)&0x80) {
-    const uint16_t* screenSource = screenBase + 0x400 * (xxx >> 8) + ((xxx & 255) >> 3) + yshift;
-    for (int x = 0; x < 240; x++) {
-      uint16_t data = READ16LE(screenSource);
-
-      int tile = data & 0x3FF;
-      int tileX = (xxx & 7);
-      int tileY = yyy & 7;
-
-      if (tileX == 7)
-        screenSource++;
-
-      if (data & 0x0400)
-        tileX = 7 - tileX;
-      if (data & 0x0800)
-        tileY = 7 - tileY;
-
-      const size_t charBankOffset = tile * 64 + tileY * 8 + tileX;
-      const size_t charBankTotalOffset = charBankOffset + charBankBaseOffset;
-      uint8_t color;
-      if (charBankTotalOffset >= 0x10000) {
-          // Adapted from https://github.com/mgba-emu/mgba/commit/4ce9b83362ad66b1421afea7372adfc753bce97c
-          // Real hardware PPU uses the most recently read from background
-          // VRAM. This can't be easily emulated in vba-m, so we simply
-          // use 0 here.
-          color = 0;
-      } else {
-          color = g_vram[charBankTotalOffset];
-      }
-
-      line[x] = color ? (READ16LE(&palette[color]) | prio) : 0x80000000;
-
-      xxx++;
-      if (xxx == 256) {
-        if (sizeX > 256)
-          screenSource = screenBase + 0x400 + yshift;
-        else {
-          screenSource = screenBase + yshift;
-          xxx = 0;
+  const bool is256Colors = control & 0x80;
+  const uint16_t* screenSource = screenBase + 0x400 * (xxx >> 8) + ((xxx & 255) >> 3) + yshift;
+  int x = 0;
+  while (x < 240) {
+    uint16_t data = READ16LE(screenSource);
+
+    int tile = data & 0x3FF;
+    int tileX = (xxx & 7);
+    int tileY = yyy & 7;
+
+    if (data & 0x0800)
+      tileY = 7 - tileY;
+
+    uint8_t colors[8]{};
+    int pal = 0;
+    if (is256Colors) {
+      const size_t charBankTotalOffset = tile * 64 + tileY * 8 + charBankBaseOffset;
+      // Adapted from https://github.com/mgba-emu/mgba/commit/4ce9b83362ad66b1421afea7372adfc753bce97c
+      // Real hardware PPU uses the most recently read from background
+      // VRAM. This can't be easily emulated in vba-m, so we simply
+      // use 0 here.
+      if (charBankTotalOffset < 0x10000)
+        memcpy(colors, &g_vram[charBankTotalOffset], 8);
+    } else {
+      const size_t charBankTotalOffset = (tile << 5) + (tileY << 2) + charBankBaseOffset;
+      if (charBankTotalOffset < 0x10000) {
+        for (int i = 0; i < 4; i++) {
+          uint8_t packed = g_vram[charBankTotalOffset + i];
+          colors[i * 2] = packed & 0x0F;
+          colors[i * 2 + 1] = packed >> 4;
         }
-      } else if (xxx >= sizeX) {
-        xxx = 0;
-        screenSource = screenBase + yshift;
       }
+      pal = (data >> 8) & 0xF0;
     }
-  } else {
-    const uint16_t* screenSource = screenBase + 0x400 * (xxx >> 8) + ((xxx & 255) >> 3) + yshift;
-    for (int x = 0; x < 240; x++) {
-      uint16_t data = READ16LE(screenSource);
-
-      int tile = data & 0x3FF;
-      int tileX = (xxx & 7);
-      int tileY = yyy & 7;
 
-      if (tileX == 7)
-        screenSource++;
-
-      if (data & 0x0400)
-        tileX = 7 - tileX;
-      if (data & 0x0800)
-        tileY = 7 - tileY;
-
-      const size_t charBankOffset = (tile << 5) + (tileY << 2) + (tileX >> 1);
-      const size_t charBankTotalOffset = charBankOffset + charBankBaseOffset;
-      uint8_t color;
-      if (charBankTotalOffset >= 0x10000) {
-          // Adapted from https://github.com/mgba-emu/mgba/commit/4ce9b83362ad66b1421afea7372adfc753bce97c
-          // Real hardware PPU uses the most recently read from background
-          // VRAM. This can't be easily emulated in vba-m, so we simply
-          // use 0 here.
-          color = 0;
-      } else {
-         color = g_vram[charBankTotalOffset];
-      if (tileX & 1) {
-        color = (color >> 4);
-      } else {
-        color &= 0x0F;
-      }
-      }
-
-      int pal = (data >> 8) & 0xF0;
-      line[x] = color ? (READ16LE(&palette[pal + color]) | prio) : 0x80000000;
+    const int pixels = std::min(8 - tileX, 240 - x);
+    const int flipMask = (data & 0x0400) ? 7 : 0;
+    for (int i = tileX; i < tileX + pixels; i++) {
+      uint8_t color = colors[i ^ flipMask];
+      line[x++] = color ? (READ16LE(&palette[pal + color]) | prio) : 0x80000000;
+    }
 
-      xxx++;
-      if (xxx == 256) {
-        if (sizeX > 256)
-          screenSource = screenBase + 0x400 + yshift;
-        else {
-          screenSource = screenBase + yshift;
-          xxx = 0;
-        }
-      } else if (xxx >= sizeX) {
-        xxx = 0;
+    screenSource++;
+    xxx += pixels;
+    if (xxx == 256) {
+      if (sizeX > 256)
+        screenSource = screenBase + 0x400 + yshift;
+      else {
         screenSource = screenBase + yshift;
+        xxx = 0;
       }
+    } else if (xxx >= sizeX) {
+      xxx = 0;
+      screenSource = screenBase + yshift;
     }
   }
   if (mosaicOn) {
@@ -52,6 +52,8 @@ FS::FileString LynxSystem::stateFilename(int slot, std::string_view name) const
 size_t LynxSystem::stateSize() { return stateSizeMDFN(); }
 void LynxSystem::readState(EmuApp&, std::span<uint8_t> buff) { readStateMDFN(buff); }
 size_t LynxSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
+void LynxSystem::readStateStream(EmuApp&, IO &io) { readStateStreamMDFN(io); }
+void LynxSystem::writeStateStream(IO &io) { writeStateStreamMDFN(io); }
 
 void LynxSystem::closeSystem()
 {
@@ -96,7 +98,7 @@ void LynxSystem::configAudioRate(FrameRate outputFrameRate, int outputRate)
 void LynxSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo* video, EmuAudio* audio)
 {
 	static constexpr size_t maxAudioFrames = 48000 / 20; // May output a large amount of audio samples during boot
-	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
+	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames, {.renderToVideoImage = true});
 	if(configuredHCount != Lynx_HCount()) [[unlikely]]
 	{
 		onFrameRateChanged();
@@ -128,7 +130,7 @@ extern "C++" namespace Mednafen
 
 void MDFND_commitVideoFrame(EmulateSpecStruct* espec)
 {
-	espec->video->startFrameWithFormat(espec->taskCtx, static_cast<EmuEx::LynxSystem&>(*espec->sys).mSurfacePix);
+	EmuEx::commitVideoFrame(*espec, static_cast<EmuEx::LynxSystem&>(*espec->sys).mSurfacePix);
 }
 
 }
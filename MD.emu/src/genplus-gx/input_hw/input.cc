@@ -30,6 +30,7 @@
 #include "teamplayer.h"
 #include "paddle.h"
 #include "sportspad.h"
+import emuex;
 
 t_input input;
 int old_system[2] = {-1,-1};
@@ -321,6 +322,10 @@ void input_reset(void)
 void input_refresh(void)
 {
   int i;
+
+  /* apply input that arrived while the frame has been emulating, the frame starts on the last line */
+  EmuEx::gSystem().subFrameInput.poll(((v_counter + 1) % lines_per_frame) / (float)lines_per_frame);
+
   for (i=0; i<MAX_DEVICES; i++)
   {
     switch (input.dev[i])
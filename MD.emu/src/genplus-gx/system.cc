@@ -536,7 +536,7 @@ static void system_frame_md(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo
     /* render scanline */
     if (!do_skip)
     {
-      render_line(line, pixmap);
+      render_line_deferred(line, pixmap);
     }
 
     /* run 68k & Z80 */
@@ -568,6 +568,9 @@ static void system_frame_md(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo
   }
   while (++line < bitmap.viewport.h);
 
+  /* finish deferred line rendering before the frame is presented */
+  render_sync();
+
   if(emuVideo)
   {
   	emuVideo->startFrameWithAltFormat(taskCtx, pixmap);
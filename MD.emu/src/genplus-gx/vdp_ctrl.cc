@@ -417,6 +417,9 @@ int vdp_context_load(uint8 *state)
 
 void vdp_dma_update(unsigned int cycles)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   int dma_cycles;
 
   /* DMA transfer rate (bytes per line)
@@ -555,6 +558,9 @@ void vdp_dma_update(unsigned int cycles)
 
 void vdp_68k_ctrl_w(unsigned int data)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Check pending flag */
   if (pending == 0)
   {
@@ -697,6 +703,9 @@ void vdp_68k_ctrl_w(unsigned int data)
 
 void vdp_z80_ctrl_w(unsigned int data)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   switch (pending)
   {
     case 0:
@@ -828,6 +837,9 @@ void vdp_z80_ctrl_w(unsigned int data)
  */
 unsigned int vdp_68k_ctrl_r(unsigned int cycles)
 {
+  /* Finish deferred lines that can still set the SCOL flag */
+  render_sync_status();
+
   /* Update FIFO flags */
   vdp_fifo_update(cycles);
 
@@ -886,6 +898,9 @@ unsigned int vdp_68k_ctrl_r(unsigned int cycles)
 
 unsigned int vdp_z80_ctrl_r(unsigned int cycles)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Update DMA Busy flag (Mega Drive VDP specific) */
   if (/*(system_hw & SYSTEM_MD) &&*/ (status & 2) && !dma_length && (cycles >= dma_endCycles))
   {
@@ -1841,6 +1856,9 @@ static void vdp_bus_w(unsigned int data)
 
 static void vdp_68k_data_w_m4(unsigned int data)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -1930,6 +1948,9 @@ static void vdp_68k_data_w_m4(unsigned int data)
 
 static void vdp_68k_data_w_m5(unsigned int data)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -1985,6 +2006,9 @@ static void vdp_68k_data_w_m5(unsigned int data)
 
 static unsigned int vdp_68k_data_r_m4(void)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2000,6 +2024,9 @@ static unsigned int vdp_68k_data_r_m4(void)
 
 static unsigned int vdp_68k_data_r_m5(void)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   uint16 data = 0;
 
   /* Clear pending flag */
@@ -2065,6 +2092,9 @@ static unsigned int vdp_68k_data_r_m5(void)
 
 static void vdp_z80_data_w_m4(unsigned int data)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2116,6 +2146,9 @@ static void vdp_z80_data_w_m4(unsigned int data)
 
 static void vdp_z80_data_w_m5(unsigned int data)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2223,6 +2256,9 @@ static void vdp_z80_data_w_m5(unsigned int data)
 
 static unsigned int vdp_z80_data_r_m4(void)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2241,6 +2277,9 @@ static unsigned int vdp_z80_data_r_m4(void)
 
 static unsigned int vdp_z80_data_r_m5(void)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   unsigned int data = 0;
 
   /* Clear pending flag */
@@ -2295,6 +2334,9 @@ static unsigned int vdp_z80_data_r_m5(void)
 #if 0
 static void vdp_z80_data_w_ms(unsigned int data)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2360,6 +2402,9 @@ static void vdp_z80_data_w_ms(unsigned int data)
 
 static void vdp_z80_data_w_gg(unsigned int data)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2433,6 +2478,9 @@ static void vdp_z80_data_w_gg(unsigned int data)
 
 static void vdp_z80_data_w_sg(unsigned int data)
 {
+  /* Finish pending deferred line rendering */
+  render_sync();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -23,6 +23,8 @@
 
 #include "shared.h"
 #include "vdp_render.h"
+#include <algorithm>
+#include <atomic>
 
 #ifdef NGC
 #include "md_ntsc.h"
@@ -405,7 +407,7 @@ static __inline__ void WRITE_LONG(void *address, uint32 data)
     { \
       temp |= (lb[i] << 8); \
       lb[i] = TABLE[temp | ATTR]; \
-      status |= ((temp & 0x8000) >> 10); \
+      spr_col_flag |= ((temp & 0x8000) >> 10); \
     } \
   }
 
@@ -419,7 +421,7 @@ static __inline__ void WRITE_LONG(void *address, uint32 data)
       lb[i] = TABLE[temp | ATTR]; \
       if ((temp & 0x8000) && !(status & 0x20)) \
       { \
-        spr_col = (v_counter << 8) | ((xpos + i + 13) >> 1); \
+        spr_col = (spr_line << 8) | ((xpos + i + 13) >> 1); \
         status |= 0x20; \
       } \
     } \
@@ -435,7 +437,7 @@ static __inline__ void WRITE_LONG(void *address, uint32 data)
       lb[i] = TABLE[temp | ATTR]; \
       if ((temp & 0x8000) && !(status & 0x20)) \
       { \
-        spr_col = (v_counter << 8) | ((xpos + i + 13) >> 1); \
+        spr_col = (spr_line << 8) | ((xpos + i + 13) >> 1); \
         status |= 0x20; \
       } \
       temp &= 0x00FF; \
@@ -443,7 +445,7 @@ static __inline__ void WRITE_LONG(void *address, uint32 data)
       lb[i+1] = TABLE[temp | ATTR]; \
       if ((temp & 0x8000) && !(status & 0x20)) \
       { \
-        spr_col = (v_counter << 8) | ((xpos + i + 1 + 13) >> 1); \
+        spr_col = (spr_line << 8) | ((xpos + i + 1 + 13) >> 1); \
         status |= 0x20; \
       } \
     } \
@@ -508,19 +510,31 @@ static uint8 linebuf[2][0x200];
 static uint8 spr_ovr;
 
 /* Sprites parsing */
-static struct 
+typedef struct
 {
   uint16 ypos;
   uint16 xpos;
   uint16 attr;
   uint16 size;
-} object_info[20];
+} object_info_t;
+
+static object_info_t object_info[20];
 
 uint8 object_count;
 
+/* Sprites drawn by render_obj(), either the parsed list or the copy queued with a deferred line */
+static const object_info_t *obj_list = object_info;
+static int obj_list_count;
+
 /* Sprite Collision Info */
 uint16 spr_col;
 
+/* Mode 5 sprite collision flag, merged into the status register by the caller of render_line_objs() */
+static uint16 spr_col_flag;
+
+/* Line being drawn, latched as the Mode 4 collision position */
+static int spr_line;
+
 /* Function pointers */
 void (*render_bg)(int line, int width);
 void (*render_obj)(int max_width);
@@ -2834,16 +2848,16 @@ void render_obj_m4(int max_width)
   spr_ovr = 0;
 
   /* Draw sprites in front-to-back order */
-  for (count = 0; count < object_count; count++)
+  for (count = 0; count < obj_list_count; count++)
   {
     /* Sprite pattern index */
-    temp = (object_info[count].attr | 0x100) & sg_mask;
+    temp = (obj_list[count].attr | 0x100) & sg_mask;
 
     /* Pointer to pattern cache line */
-    src = (uint8 *)&bg_pattern_cache[(temp << 6) | (object_info[count].ypos << 3)];
+    src = (uint8 *)&bg_pattern_cache[(temp << 6) | (obj_list[count].ypos << 3)];
 
     /* Sprite X position */
-    xpos = object_info[count].xpos;
+    xpos = obj_list[count].xpos;
 
     /* X position shift */
     xpos -= (reg[0] & 0x08);
@@ -2899,10 +2913,10 @@ void render_obj_m5(int max_width)
 #endif
 
   /* Draw sprites in front-to-back order */
-  for (count = 0; count < object_count; count++)
+  for (count = 0; count < obj_list_count; count++)
   {
     /* Sprite X position */
-    xpos = object_info[count].xpos;
+    xpos = obj_list[count].xpos;
 
     /* Sprite masking  */
     if (xpos)
@@ -2920,7 +2934,7 @@ void render_obj_m5(int max_width)
     xpos = xpos - 0x80;
 
     /* Sprite size */
-    temp = object_info[count].size;
+    temp = obj_list[count].size;
 
     /* Sprite width */
     width = 8 + ((temp & 0x0C) << 1);
@@ -2932,10 +2946,10 @@ void render_obj_m5(int max_width)
     if (((xpos + width) > 0) && (xpos < max_width) && !masked)
     {
       /* Sprite attributes */
-      attr = object_info[count].attr;
+      attr = obj_list[count].attr;
 
       /* Sprite vertical offset */
-      v_line = object_info[count].ypos;
+      v_line = obj_list[count].ypos;
 
       /* Sprite priority + palette bits */
       atex = (attr >> 9) & 0x70;
@@ -3008,10 +3022,10 @@ void render_obj_m5_ste(int max_width)
   memset(&linebuf[1][0], 0, max_width + 0x40);
 
   /* Draw sprites in front-to-back order */
-  for (count = 0; count < object_count; count++)
+  for (count = 0; count < obj_list_count; count++)
   {
     /* Sprite X position */
-    xpos = object_info[count].xpos;
+    xpos = obj_list[count].xpos;
 
     /* Sprite masking  */
     if (xpos)
@@ -3029,7 +3043,7 @@ void render_obj_m5_ste(int max_width)
     xpos = xpos - 0x80;
 
     /* Sprite size */
-    temp = object_info[count].size;
+    temp = obj_list[count].size;
 
     /* Sprite width */
     width = 8 + ((temp & 0x0C) << 1);
@@ -3041,10 +3055,10 @@ void render_obj_m5_ste(int max_width)
     if (((xpos + width) > 0) && (xpos < max_width) && !masked)
     {
       /* Sprite attributes */
-      attr = object_info[count].attr;
+      attr = obj_list[count].attr;
 
       /* Sprite vertical offset */
-      v_line = object_info[count].ypos;
+      v_line = obj_list[count].ypos;
 
       /* Sprite priority + palette bits */
       atex = (attr >> 9) & 0x70;
@@ -3121,10 +3135,10 @@ void render_obj_m5_im2(int max_width)
 #endif
 
   /* Draw sprites in front-to-back order */
-  for (count = 0; count < object_count; count++)
+  for (count = 0; count < obj_list_count; count++)
   {
     /* Sprite X position */
-    xpos = object_info[count].xpos;
+    xpos = obj_list[count].xpos;
 
     /* Sprite masking  */
     if (xpos)
@@ -3142,7 +3156,7 @@ void render_obj_m5_im2(int max_width)
     xpos = xpos - 0x80;
 
     /* Sprite size */
-    temp = object_info[count].size;
+    temp = obj_list[count].size;
 
     /* Sprite width */
     width = 8 + ((temp & 0x0C) << 1);
@@ -3154,10 +3168,10 @@ void render_obj_m5_im2(int max_width)
     if (((xpos + width) > 0) && (xpos < max_width) && !masked)
     {
       /* Sprite attributes */
-      attr = object_info[count].attr;
+      attr = obj_list[count].attr;
 
       /* Sprite y offset */
-      v_line = object_info[count].ypos;
+      v_line = obj_list[count].ypos;
 
       /* Sprite priority + palette bits */
       atex = (attr >> 9) & 0x70;
@@ -3231,10 +3245,10 @@ void render_obj_m5_im2_ste(int max_width)
   memset(&linebuf[1][0], 0, max_width + 0x40);
 
   /* Draw sprites in front-to-back order */
-  for (count = 0; count < object_count; count++)
+  for (count = 0; count < obj_list_count; count++)
   {
     /* Sprite X position */
-    xpos = object_info[count].xpos;
+    xpos = obj_list[count].xpos;
 
     /* Sprite masking  */
     if (xpos)
@@ -3252,7 +3266,7 @@ void render_obj_m5_im2_ste(int max_width)
     xpos = xpos - 0x80;
 
     /* Sprite size */
-    temp = object_info[count].size;
+    temp = obj_list[count].size;
 
     /* Sprite width */
     width = 8 + ((temp & 0x0C) << 1);
@@ -3264,10 +3278,10 @@ void render_obj_m5_im2_ste(int max_width)
     if (((xpos + width) > 0) && (xpos < max_width) && !masked)
     {
       /* Sprite attributes */
-      attr = object_info[count].attr;
+      attr = obj_list[count].attr;
 
       /* Sprite y offset */
-      v_line = object_info[count].ypos;
+      v_line = obj_list[count].ypos;
 
       /* Sprite priority + palette bits */
       atex = (attr >> 9) & 0x70;
@@ -3704,7 +3718,7 @@ void render_reset(void)
 /* Line rendering functions                                                 */
 /*--------------------------------------------------------------------------*/
 
-void render_line(int line, IG::MutablePixmapView pix)
+static void render_line_objs(int line, IG::MutablePixmapView pix, const object_info_t *objs, int count)
 {
   int width = bitmap.viewport.w;
 
@@ -3722,6 +3736,9 @@ void render_line(int line, IG::MutablePixmapView pix)
     render_bg(line, width);
 
     /* Render sprite layer */
+    obj_list = objs;
+    obj_list_count = count;
+    spr_line = line;
     render_obj(width);
 
     /* Left-most column blanking */
@@ -3729,12 +3746,6 @@ void render_line(int line, IG::MutablePixmapView pix)
     {
       memset(&linebuf[0][0x20], 0x40, 8);
     }
-
-    /* Parse sprites for next line */
-    if (line < (bitmap.viewport.h - 1))
-    {
-      parse_satb(line);
-    }
   }
   else
   {
@@ -3755,6 +3766,179 @@ void render_line(int line, IG::MutablePixmapView pix)
   	remap_line(line, pix);
 }
 
+/* Parse sprites for next line */
+static void render_parse_next(int line)
+{
+  if ((reg[1] & 0x40) && (line < (bitmap.viewport.h - 1)))
+  {
+    parse_satb(line);
+  }
+}
+
+void render_line(int line, IG::MutablePixmapView pix)
+{
+  render_line_objs(line, pix, object_info, object_count);
+
+  /* Set SCOL flag */
+  status |= spr_col_flag;
+  spr_col_flag = 0;
+
+  render_parse_next(line);
+}
+
+/*--------------------------------------------------------------------------*/
+/* Deferred line rendering                                                  */
+/*--------------------------------------------------------------------------*/
+
+/* When enabled, Mode 5 lines queued by render_line_deferred() are rendered in
+   order on a worker thread while the CPUs emulate the same line. Sprites for
+   the next line are still parsed on the calling thread at the same point as
+   render_line() and each job carries its own copy of the sprite list, so the
+   overflow flag is set on time. The worker only reports sprite collisions,
+   which render_sync_status() merges into the status register once the lines
+   that could have set it are done. Any other VDP access that can modify
+   rendering state first calls render_sync(), so mid-frame writes are applied
+   exactly as if each line had been rendered synchronously. Mode 4 sprites
+   latch collision and overflow state while drawing, so those lines are always
+   rendered inline.
+*/
+
+static constexpr int RENDER_EXIT = -0x8000;
+
+static struct
+{
+  int line;
+  IG::MutablePixmapView pix;
+  uint8 obj_count;
+  object_info_t objs[20];
+} render_jobs[0x200];
+
+static std::atomic_uint32_t render_queued;
+static std::atomic_uint32_t render_done;
+/* Collision flags reported by the worker, pending merge into the status register */
+static std::atomic_uint16_t render_col;
+/* Queue position after the last line that can report a collision */
+static uint32 render_col_pos;
+static std::thread render_thread;
+static IG::ThreadId render_tid;
+
+static void render_thread_main(void)
+{
+  uint32 pos = render_done.load(std::memory_order_relaxed);
+  for(;;)
+  {
+    render_queued.wait(pos, std::memory_order_acquire);
+    const auto &job = render_jobs[pos % std::size(render_jobs)];
+    if (job.line == RENDER_EXIT)
+      return;
+    render_line_objs(job.line, job.pix, job.objs, job.obj_count);
+    if (spr_col_flag)
+    {
+      render_col.fetch_or(spr_col_flag, std::memory_order_relaxed);
+      spr_col_flag = 0;
+    }
+    render_done.store(++pos, std::memory_order_release);
+    render_done.notify_one();
+  }
+}
+
+static void render_wait(uint32 pos)
+{
+  for (uint32 done = render_done.load(std::memory_order_acquire); int32(done - pos) < 0;
+    done = render_done.load(std::memory_order_acquire))
+  {
+    render_done.wait(done, std::memory_order_acquire);
+  }
+  if (render_col.load(std::memory_order_relaxed))
+  {
+    status |= render_col.exchange(0, std::memory_order_relaxed);
+  }
+}
+
+static void render_push(int line, IG::MutablePixmapView pix)
+{
+  uint32 pos = render_queued.load(std::memory_order_relaxed);
+  if (pos - render_done.load(std::memory_order_acquire) == std::size(render_jobs))
+  {
+    render_sync();
+  }
+  auto &job = render_jobs[pos % std::size(render_jobs)];
+  job.line = line;
+  job.pix = pix;
+  job.obj_count = 0;
+  if (reg[1] & 0x40)
+  {
+    job.obj_count = object_count;
+    std::copy_n(object_info, object_count, job.objs);
+    /* Collisions need at least two sprites on the line */
+    if (object_count > 1)
+    {
+      render_col_pos = pos + 1;
+    }
+  }
+  render_queued.store(pos + 1, std::memory_order_release);
+  render_queued.notify_one();
+}
+
+void render_line_deferred(int line, IG::MutablePixmapView pix)
+{
+  if (!render_thread.joinable() || !(reg[1] & 0x04))
+  {
+    render_sync();
+    render_line(line, pix);
+    return;
+  }
+  render_push(line, pix);
+  render_parse_next(line);
+}
+
+void render_sync(void)
+{
+  uint32 pos = render_queued.load(std::memory_order_relaxed);
+  render_wait(pos);
+  render_col_pos = pos;
+}
+
+void render_sync_status(void)
+{
+  render_wait(render_col_pos);
+}
+
+void render_set_thread(int enable)
+{
+  if (enable == render_thread.joinable())
+    return;
+  if (enable)
+  {
+    render_thread = IG::makeThreadSync([](auto &sem)
+    {
+      render_tid = IG::thisThreadId();
+      sem.release();
+      render_thread_main();
+    });
+  }
+  else
+  {
+    render_sync();
+    render_push(RENDER_EXIT, {});
+    render_thread.join();
+    render_queued.store(0, std::memory_order_relaxed);
+    render_done.store(0, std::memory_order_relaxed);
+    render_col_pos = 0;
+    render_tid = {};
+  }
+}
+
+IG::ThreadId render_thread_id(void)
+{
+  return render_tid;
+}
+
+static struct RenderThreadExit
+{
+  ~RenderThreadExit() { render_set_thread(0); }
+} render_thread_exit;
+
 void blank_line(int line, int offset, int width)
 {
   memset(&linebuf[0][0x20 + offset], 0x40, width);
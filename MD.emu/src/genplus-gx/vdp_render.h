@@ -25,6 +25,7 @@
 #define _RENDER_H_
 
 #include <imagine/pixmap/Pixmap.hh>
+#include <imagine/thread/Thread.hh>
 #include <type_traits>
 
 static constexpr unsigned RENDER_BPP = 32;
@@ -38,6 +39,11 @@ extern uint16 spr_col;
 extern void render_init(void);
 extern void render_reset(void);
 extern void render_line(int line, IG::MutablePixmapView pix);
+extern void render_line_deferred(int line, IG::MutablePixmapView pix);
+extern void render_sync(void);
+extern void render_sync_status(void);
+extern void render_set_thread(int enable);
+extern IG::ThreadId render_thread_id(void);
 extern void blank_line(int line, int offset, int width);
 extern void remap_line(int line, IG::MutablePixmapView pix);
 extern void remapPixmap(IG::MutablePixmapView dest, IG::PixmapView src);
@@ -18,6 +18,7 @@
 #include "system.h"
 #include "io_ctrl.h"
 #include "vdp_ctrl.h"
+#include "vdp_render.h"
 import system;
 import emuex;
 import imagine;
@@ -258,11 +259,23 @@ class CustomSystemOptionView : public SystemOptionView, public MainAppHelper
 		}
 	};
 
+	BoolMenuItem renderThread
+	{
+		"Threaded Video Rendering", attachParams(),
+		(bool)system().optionRenderThread,
+		[this](BoolMenuItem &item)
+		{
+			system().optionRenderThread = item.flipBoolValue(*this);
+			render_set_thread(system().optionRenderThread);
+		}
+	};
+
 public:
 	CustomSystemOptionView(ViewAttachParams attach): SystemOptionView{attach, true}
 	{
 		loadStockItems();
 		item.emplace_back(&bigEndianSram);
+		item.emplace_back(&renderThread);
 	}
 };
 
@@ -72,6 +72,12 @@ void MdSystem::renderFramebuffer(EmuVideo& video)
 	video.startFrameWithAltFormat({}, framebufferRenderFormatPixmap());
 }
 
+void MdSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
+{
+	if(auto id = render_thread_id())
+		ids.emplace_back(id);
+}
+
 VideoSystem MdSystem::videoSystem() const { return vdp_pal ? VideoSystem::PAL : VideoSystem::NATIVE_NTSC; }
 
 void MdSystem::reset(EmuApp &, ResetMode mode)
@@ -273,7 +279,8 @@ void MdSystem::loadContent(IO& io, EmuSystemCreateParams, OnLoadProgressDelegate
 		(hasBinExtension(contentFileName()) && io.size() > 1024*1024*10)) // CD
 	{
 		bool isArchive = std::holds_alternative<ArchiveIO>(io);
-		if(contentDirectory().empty() && !isArchive)
+		bool isCached = contentCacheDirectory().size();
+		if(contentDirectory().empty() && !isArchive && !isCached)
 		{
 			throwMissingContentDirError();
 		}
@@ -303,6 +310,22 @@ void MdSystem::loadContent(IO& io, EmuSystemCreateParams, OnLoadProgressDelegate
 			ArchiveVFS archVFS{ArchiveIO{std::move(io)}};
 			cd = CDAccess_Open(&archVFS, std::string{contentFileName()}, true);
 		}
+		else if(isCached)
+		{
+			if(endsWithAnyCaseless(contentFileName(), ".bin", ".iso"))
+			{
+				// check the extracted archive for a .cue and load that instead
+				FS::forEachInDirectory(contentCacheDirectory(), [&](auto &entry)
+				{
+					if(!endsWithAnyCaseless(entry.name(), ".cue"))
+						return true;
+					log.info("found:{}", entry.name());
+					contentFileName_ = entry.name();
+					return false;
+				});
+			}
+			cd = CDAccess_Open(&NVFS, std::string{FS::pathString(contentCacheDirectory(), contentFileName())}, false);
+		}
 		else
 		{
 			cd = CDAccess_Open(&NVFS, std::string{contentLocation()}, false);
@@ -291,6 +291,9 @@ bool FCEUI_GetNetPlayPause();
 //indicates whether input aids should be drawn (such as crosshairs, etc; usually in fullscreen mode)
 bool FCEUD_ShouldDrawInputAids();
 
+//applies input that arrived while the frame has been emulating up to framePos (0-1), returns true if any changed
+bool FCEUD_PollInput(float framePos);
+
 ///called when the emulator closes a game
 void FCEUD_OnCloseGame(void);
 
@@ -161,6 +161,23 @@ static DECLFR(JPRead)
 	return(ret);
 }
 
+//latch input that arrived while the frame has been emulating when the game strobes the pads
+static void UpdateGPMidFrame(void)
+{
+	//timestamp counts cpu cycles since the start of the frame
+	const float frameCycles = (PAL || dendy ? 312 : 262) * 341 / (PAL ? 3.2f : 3.f);
+	if(!FCEUD_PollInput(timestamp / frameCycles))
+		return;
+	//input recorded or replayed for this frame and the vs swap are only handled by FCEU_UpdateInput
+	if(!FCEUMOV_Mode(MOVIEMODE_INACTIVE) || FCEUnetplay || GameInfo->type == GIT_VSUNI)
+		return;
+	for(int port=0;port<2;port++)
+	{
+		if(joyports[port].type == SI_GAMEPAD)
+			joyports[port].driver->Update(port,joyports[port].ptr,joyports[port].attrib);
+	}
+}
+
 static DECLFW(B4016)
 {
 	if(portFC.driver)
@@ -180,6 +197,7 @@ static DECLFW(B4016)
 
 		//mbg 6/7/08 - I guess he means that the input drivers could track the strobing themselves
 		//I dont see why it is unreasonable here.
+		UpdateGPMidFrame();
 		for(int i=0;i<2;i++)
 			joyports[i].driver->Strobe(i);
 		if(portFC.driver)
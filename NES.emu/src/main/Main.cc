@@ -437,6 +437,11 @@ extern "C++" void FCEUPPU_FrameReady(EmuEx::EmuSystemTaskContext taskCtx, EmuEx:
 	sys.renderVideo(taskCtx, *video, buf);
 }
 
+extern "C++" bool FCEUD_PollInput(float framePos)
+{
+	return EmuEx::gSystem().subFrameInput.poll(framePos);
+}
+
 extern "C++" void setDiskIsAccessing(bool on)
 {
 	using namespace EmuEx;
@@ -49,6 +49,8 @@ FS::FileString NgpSystem::stateFilename(int slot, std::string_view name) const
 size_t NgpSystem::stateSize() { return stateSizeMDFN(); }
 void NgpSystem::readState(EmuApp&, std::span<uint8_t> buff) { readStateMDFN(buff); }
 size_t NgpSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
+void NgpSystem::readStateStream(EmuApp&, IO &io) { readStateStreamMDFN(io); }
+void NgpSystem::writeStateStream(IO &io) { writeStateStreamMDFN(io); }
 
 static FS::PathString saveFilename(const EmuApp &app)
 {
@@ -105,7 +107,7 @@ void NgpSystem::configAudioRate(FrameRate outputFrameRate, int outputRate)
 void NgpSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	static constexpr size_t maxAudioFrames = 48000 / AppMeta::minFrameRate;
-	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
+	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames, {.renderToVideoImage = true});
 }
 
 }
@@ -137,7 +139,7 @@ extern "C++" namespace Mednafen
 
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
 {
-	espec->video->startFrameWithFormat(espec->taskCtx, static_cast<NgpSystem&>(*espec->sys).mSurfacePix);
+	EmuEx::commitVideoFrame(*espec, static_cast<NgpSystem&>(*espec->sys).mSurfacePix);
 }
 
 }
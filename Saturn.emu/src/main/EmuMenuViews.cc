@@ -618,6 +618,16 @@ class CustomVideoOptionView : public VideoOptionView, public MainAppHelper
 		}
 	};
 
+	BoolMenuItem vdp1RenderThread
+	{
+		"Threaded VDP1 Rendering", attachParams(),
+		system().vdp1RenderThread,
+		[this](BoolMenuItem &item)
+		{
+			system().setVDP1RenderThread(item.flipBoolValue(*this));
+		}
+	};
+
 public:
 	CustomVideoOptionView(ViewAttachParams attach, EmuVideoLayer &layer): VideoOptionView{attach, layer, true}
 	{
@@ -626,6 +636,7 @@ public:
 		item.emplace_back(&showHOverscan);
 		item.emplace_back(&visibleVideoLines);
 		item.emplace_back(&correctLineAspect);
+		item.emplace_back(&vdp1RenderThread);
 	}
 };
 
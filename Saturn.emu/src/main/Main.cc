@@ -219,11 +219,52 @@ static ArchiveIO scanCDImages(ArchiveIO arch)
 	}
 }
 
+static FS::FileString scanCachedCDImages(CStringView dir)
+{
+	std::vector<FS::FileString> names;
+	FS::forEachInDirectory(dir, [&](auto &entry)
+	{
+		if(AppMeta::defaultFsFilter(entry.name()))
+			names.emplace_back(entry.name());
+		return true;
+	});
+	std::ranges::sort(names);
+	// prioritize .m3u like in archives
+	if(auto it = std::ranges::find_if(names, [](auto &n) { return isM3U(n); });
+		it != names.end())
+	{
+		return *it;
+	}
+	return names.size() ? names.front() : FS::FileString{};
+}
+
 void SaturnSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate)
 {
 	bool isArchive = EmuApp::hasArchiveExtension(contentFileName());
 	auto unloadCD = scopeGuard([&]() { clearCDInterfaces(CDInterfaces); });
-	if(isArchive)
+	if(const auto &cacheDir = contentCacheDirectory();
+		cacheDir.size())
+	{
+		auto cdImgName = scanCachedCDImages(cacheDir);
+		if(cdImgName.empty())
+			throw std::runtime_error("No recognized file extensions in archive");
+		contentFileName_ = cdImgName;
+		std::vector<std::string> filenames;
+		if(isM3U(cdImgName))
+		{
+			FileIO m3uFile{FS::pathString(cacheDir, cdImgName)};
+			filenames = m3uFilenames(m3uFile);
+		}
+		else
+		{
+			filenames.emplace_back(cdImgName);
+		}
+		for(auto &fn : filenames)
+		{
+			CDInterfaces.emplace_back(CDInterface::Open(&NVFS, std::string{FS::pathString(cacheDir, FS::basename(fn))}, false, 0));
+		}
+	}
+	else if(isArchive)
 	{
 		auto cdImgFile = scanCDImages(ArchiveIO{std::move(io)});
 		if(!cdImgFile)
@@ -392,6 +433,8 @@ double SaturnSystem::videoAspectRatioScale() const
 size_t SaturnSystem::stateSize() { return currStateSize; }
 void SaturnSystem::readState(EmuApp&, std::span<uint8_t> buff) { readStateMDFN(buff); }
 size_t SaturnSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
+void SaturnSystem::readStateStream(EmuApp&, IO &io) { readStateStreamMDFN(io); }
+void SaturnSystem::writeStateStream(IO &io) { writeStateStreamMDFN(io); }
 
 }
 
@@ -406,6 +449,10 @@ void MDFN_MidSync(EmulateSpecStruct *espec, const unsigned flags)
 	espec->audio->writeFrames(espec->SoundBuf, std::exchange(espec->SoundBufSize, 0));
 }
 
+// The surface is copied instead of rendered into the video texture since it must persist between frames,
+// interlaced frames only draw one field and the other comes from the previous frame. Copying the
+// visible rect costs ~10us at 320x224 and ~100us at 704x480 while an upload based texture would
+// otherwise transfer the whole 704x576 surface every frame.
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
 {
 	auto &sys = static_cast<const EmuEx::SaturnSystem&>(*espec->sys);
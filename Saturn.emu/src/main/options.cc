@@ -72,6 +72,7 @@ bool SaturnSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_DEFAULT_PAL_VIDEO_LINES: return readOptionValue(io, defaultPalLines, linesAreValid<288>);
 			case CFGKEY_DEFAULT_SHOW_H_OVERSCAN: return readOptionValue(io, defaultShowHOverscan);
 			case CFGKEY_NO_MD5_FILENAMES: return readOptionValue(io, noMD5InFilenames);
+			case CFGKEY_VDP1_RENDER_THREAD: return readOptionValue(io, vdp1RenderThread);
 		}
 	}
 	else if(type == ConfigType::SESSION)
@@ -105,6 +106,7 @@ void SaturnSystem::writeConfig(ConfigType type, FileIO &io)
 		writeOptionValueIfNotDefault(io, CFGKEY_DEFAULT_PAL_VIDEO_LINES, defaultPalLines, safePalLines);
 		writeOptionValueIfNotDefault(io, CFGKEY_DEFAULT_SHOW_H_OVERSCAN, defaultShowHOverscan, false);
 		writeOptionValueIfNotDefault(io, CFGKEY_NO_MD5_FILENAMES, noMD5InFilenames, false);
+		writeOptionValueIfNotDefault(io, CFGKEY_VDP1_RENDER_THREAD, vdp1RenderThread, false);
 	}
 	else if(type == ConfigType::SESSION)
 	{
@@ -139,7 +141,7 @@ uint64 MDFN_GetSettingUI(const char *name_)
 		return 4;
 	if("ss.smpc.autortc.lang" == name)
 		return sys.biosLanguage;
-	if("ss.affinity.vdp2" == name)
+	if("ss.affinity.vdp1" == name || "ss.affinity.vdp2" == name)
 		return 0;
 	if(name.ends_with("gun_chairs"))
 		return 0xFFFFFFFF;
@@ -200,6 +202,8 @@ bool MDFN_GetSettingB(const char *name_)
 		return sys.showHOverscan;
 	if("ss.h_blend" == name)
 		return false;
+	if("ss.vdp1_thread" == name)
+		return sys.vdp1RenderThread;
 	if("ss.region_autodetect" == name)
 		return !sys.region;
 	if("ss.smpc.autortc" == name)
@@ -1365,6 +1365,8 @@ static void MDFN_COLD InitCommon(unsigned cpucache_emumode, unsigned horrible_ha
  const char* biospath_sname;
  int sls = MDFN_GetSettingI(PAL ? "ss.slstartp" : "ss.slstart");
  int sle = MDFN_GetSettingI(PAL ? "ss.slendp" : "ss.slend");
+ const uint64 vdp1_affinity = MDFN_GetSettingUI("ss.affinity.vdp1");
+ const bool vdp1_thread = MDFN_GetSettingB("ss.vdp1_thread");
  const uint64 vdp2_affinity = MDFN_GetSettingUI("ss.affinity.vdp2");
 
  if(PAL)
@@ -1471,7 +1473,7 @@ static void MDFN_COLD InitCommon(unsigned cpucache_emumode, unsigned horrible_ha
  if(cart_type == CART_STV)
   STVIO_Init(sgi);
 
- VDP1::Init();
+ VDP1::Init(vdp1_thread, vdp1_affinity);
  VDP2::Init(PAL, vdp2_affinity);
  CDB_Init();
  SOUND_Init(cart_type == CART_STV);
@@ -2455,6 +2457,8 @@ static const MDFNSetting SSSettings[] =
  { "ss.slendp", MDFNSF_NOFLAGS, gettext_noop("Last displayed scanline in PAL mode."), NULL, MDFNST_INT, "255", "-16", "271" },
 
  { "ss.affinity.vdp2", MDFNSF_NOFLAGS, gettext_noop("VDP2 rendering thread CPU affinity mask."), gettext_noop("Set to 0 to disable changing affinity."), MDFNST_UINT, "0", "0x0000000000000000", "0xFFFFFFFFFFFFFFFF" },
+ { "ss.vdp1_thread", MDFNSF_NOFLAGS, gettext_noop("Enable VDP1 rendering thread."), gettext_noop("Draw timing is still computed on the emulation thread, so this only helps with games that spend a lot of time drawing."), MDFNST_BOOL, "0" },
+ { "ss.affinity.vdp1", MDFNSF_NOFLAGS, gettext_noop("VDP1 rendering thread CPU affinity mask."), gettext_noop("Set to 0 to disable changing affinity."), MDFNST_UINT, "0", "0x0000000000000000", "0xFFFFFFFFFFFFFFFF" },
 
 #ifdef MDFN_ENABLE_DEV_BUILD
  { "ss.dbg_mask", MDFNSF_SUPPRESS_DOC, gettext_noop("Debug printf mask."), NULL, MDFNST_MULTI_ENUM, "none", NULL, NULL, NULL, NULL, DBGMask_List },
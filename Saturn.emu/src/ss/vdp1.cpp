@@ -45,6 +45,7 @@
 #include "vdp1.h"
 #include "vdp2.h"
 #include "vdp1_common.h"
+#include "vdp1_render.h"
 
 enum : int { VDP1_UpdateTimingGran = 263 };
 enum : int { VDP1_IdleTimingGran = 1019 };
@@ -83,6 +84,7 @@ static int32 CycleCounter;
 static int32 CommandPhase;
 static uint16 CommandData[0x10];
 uint32 DTACounter;
+bool RenderThreadActive;
 
 static bool vb_status, hb_status;
 static bool vbcdpending;
@@ -211,7 +213,7 @@ static INLINE void VRAMUsageEnd(void) { }
 //
 //
 //
-void Init(void)
+void Init(const bool render_thread, const uint64 affinity)
 {
  vbcdpending = false;
 
@@ -238,15 +240,36 @@ void Init(void)
  LastRWTS = 0;
 
  VRAMUsageInit();
+
+ SetRenderThread(render_thread, affinity);
 }
 
 void Kill(void)
 {
+ SetRenderThread(false);
+}
+
+void SetRenderThread(const bool enabled, const uint64 affinity)
+{
+ if(enabled == RenderThreadActive)
+  return;
 
+ if(enabled)
+ {
+  VDP1REND_LoadDrawState(CommandData);
+  VDP1REND_Init(affinity);
+ }
+ else
+  VDP1REND_Kill();
+
+ RenderThreadActive = enabled;
 }
 
 void Reset(bool powering_up)
 {
+ if(RenderThreadActive)
+  VDP1REND_Sync();
+
  if(powering_up)
  {
   for(unsigned i = 0; i < 0x40000; i++)
@@ -319,336 +342,12 @@ void Reset(bool powering_up)
 
  memset(&EraseParams, 0, sizeof(EraseParams));
  EraseYCounter = ~0U;
-}
-
-static int32 CMD_SetUserClip(const uint16* cmd_data)
-{
- UserClipX0 = cmd_data[0x6] & 0x1FFF;
- UserClipY0 = cmd_data[0x7] & 0x1FFF;
-
- UserClipX1 = cmd_data[0xA] & 0x1FFF;
- UserClipY1 = cmd_data[0xB] & 0x1FFF;
-
- return 0;
-}
-
-int32 CMD_SetSystemClip(const uint16* cmd_data)
-{
- SysClipX = cmd_data[0xA] & 0x1FFF;
- SysClipY = cmd_data[0xB] & 0x1FFF;
-
- return 0;
-}
-
-int32 CMD_SetLocalCoord(const uint16* cmd_data)
-{
- LocalX = sign_x_to_s32(11, cmd_data[0x6] & 0x7FF);
- LocalY = sign_x_to_s32(11, cmd_data[0x7] & 0x7FF);
-
- return 0;
-}
-
-template<unsigned ECDSPDMode>
-static uint32 MDFN_FASTCALL TexFetch(uint32 x)
-{
- const uint32 base = LineData.tex_base;
- const bool ECD = ECDSPDMode & 0x10;
- const bool SPD = ECDSPDMode & 0x08;
- const unsigned ColorMode = ECDSPDMode & 0x07;
-
- uint32 rtd;
- uint32 ret_or = 0;
-
- switch(ColorMode)
- {
-  case 0:	// 16 colors, color bank
-	rtd = (VRAM[(base + (x >> 2)) & 0x3FFFF] >> (((x & 0x3) ^ 0x3) << 2)) & 0xF;
-	VRAMUsageDrawRead((base + (x >> 2)) & 0x3FFFF);
-
-	if(!ECD && rtd == 0xF)
-	{
-	 LineData.ec_count--;	
-	 return -1;
-	}
-	ret_or = LineData.cb_or;
-	
-	if(!SPD) ret_or |= (int32)(rtd - 1) >> 31;
-
-	return rtd | ret_or;
-
-  case 1:	// 16 colors, LUT
-	rtd = (VRAM[(base + (x >> 2)) & 0x3FFFF] >> (((x & 0x3) ^ 0x3) << 2)) & 0xF;
-	VRAMUsageDrawRead((base + (x >> 2)) & 0x3FFFF);
-
-	if(!ECD && rtd == 0xF)
-	{
-	 LineData.ec_count--;
-	 return -1;
-	}
-
-	if(!SPD) ret_or |= (int32)(rtd - 1) >> 31;
-
-	return LineData.CLUT[rtd] | ret_or;
-
-  case 2:	// 64 colors, color bank
-	rtd = (VRAM[(base + (x >> 1)) & 0x3FFFF] >> (((x & 0x1) ^ 0x1) << 3)) & 0xFF;
-	VRAMUsageDrawRead((base + (x >> 1)) & 0x3FFFF);
 
-	if(!ECD && rtd == 0xFF)
-	{
-	 LineData.ec_count--;
-	 return -1;
-	}
-
-	ret_or = LineData.cb_or;
-
-	if(!SPD) ret_or |= (int32)(rtd - 1) >> 31;
-
-	return (rtd & 0x3F) | ret_or;
-
-  case 3:	// 128 colors, color bank
-	rtd = (VRAM[(base + (x >> 1)) & 0x3FFFF] >> (((x & 0x1) ^ 0x1) << 3)) & 0xFF;
-	VRAMUsageDrawRead((base + (x >> 1)) & 0x3FFFF);
-
-	if(!ECD && rtd == 0xFF)
-	{
-	 LineData.ec_count--;
-	 return -1;
-	}
-
-	ret_or = LineData.cb_or;
-
-	if(!SPD) ret_or |= (int32)(rtd - 1) >> 31;
-
-	return (rtd & 0x7F) | ret_or;
-
-  case 4:	// 256 colors, color bank
-	rtd = (VRAM[(base + (x >> 1)) & 0x3FFFF] >> (((x & 0x1) ^ 0x1) << 3)) & 0xFF;
-	VRAMUsageDrawRead((base + (x >> 1)) & 0x3FFFF);
-
-	if(!ECD && rtd == 0xFF)
-	{
-	 LineData.ec_count--;
-	 return -1;
-	}
-
-	ret_or = LineData.cb_or;
-
-	if(!SPD) ret_or |= (int32)(rtd - 1) >> 31;
-
-	return rtd | ret_or;
-
-  case 5:	// 32K colors, RGB
-  case 6:
-  case 7:
-	if(ColorMode >= 6)
-	 rtd = VRAM[0];
-	else
-	 rtd = VRAM[(base + x) & 0x3FFFF];
-	VRAMUsageDrawRead((ColorMode >= 6) ? 0 : ((base + x) & 0x3FFFF));
-
-	if(!ECD && (rtd & 0xC000) == 0x4000)
-	{
-	 LineData.ec_count--;
-	 return -1;
-	}
-
-	if(!SPD) ret_or |= (int32)(rtd - 0x4000) >> 31;
-
-	return rtd | ret_or;
- }
+ if(RenderThreadActive)
+  VDP1REND_LoadDrawState(CommandData);
 }
 
-
-MDFN_HIDE extern uint32 (MDFN_FASTCALL *const TexFetchTab[0x20])(uint32 x) =
-{
- #define TF(a) (TexFetch<a>)
-
- TF(0x00), TF(0x01), TF(0x02), TF(0x03),
- TF(0x04), TF(0x05), TF(0x06), TF(0x07),
-
- TF(0x08), TF(0x09), TF(0x0A), TF(0x0B),
- TF(0x0C), TF(0x0D), TF(0x0E), TF(0x0F),
-
- TF(0x10), TF(0x11), TF(0x12), TF(0x13),
- TF(0x14), TF(0x15), TF(0x16), TF(0x17),
-
- TF(0x18), TF(0x19), TF(0x1A), TF(0x1B),
- TF(0x1C), TF(0x1D), TF(0x1E), TF(0x1F),
-
- #undef TF
-};
-
-bool SetupDrawLine(int32* const cycle_counter, const bool AA, const bool Textured, const uint16 mode)
-{
- const bool HSS = (mode & 0x1000);
- const bool PCD = (mode & 0x800);
- const bool UserClipEn = (mode & 0x400);
- const bool UserClipMode = (mode & 0x200);
- //const bool ECD = (mode & 0x80);
- //const bool SPD = (mode & 0x40);
- const bool GouraudEn = (mode & 0x8004) == 0x4;
- line_vertex p0 = LineData.p[0];
- line_vertex p1 = LineData.p[1];
- line_inner_data& lid = LineInnerData;
- bool clipped = false;
-
- p0.x &= 0x1FFF;
- p0.y &= 0x1FFF;
- p1.x &= 0x1FFF;
- p1.y &= 0x1FFF;
-
- //printf("(0x%04x,0x%04x) -> (0x%04x,0x%04x)\n", p0.x, p0.y, p1.x, p1.y);
-
- if(!PCD)
- {
-  bool swapped = false;
-
-  *cycle_counter += 4;
-
-  if(UserClipEn && !UserClipMode)
-  {
-   // Ignore system clipping WRT pre-clip for UserClipEn == 1 && UserClipMode == 0
-   clipped |= (((UserClipX1 - p0.x) & (UserClipX1 - p1.x)) | ((p0.x - UserClipX0) & (p1.x - UserClipX0))) & 0x1000;
-   clipped |= (((UserClipY1 - p0.y) & (UserClipY1 - p1.y)) | ((p0.y - UserClipY0) & (p1.y - UserClipY0))) & 0x1000;
-
-   swapped = (p0.y == p1.y) & ((p0.x < UserClipX0) | (p0.x > UserClipX1));
-  }
-  else
-  {
-   clipped |= (((SysClipX - p0.x) & (SysClipX - p1.x)) | (p0.x & p1.x)) & 0x1000;
-   clipped |= (((SysClipY - p0.y) & (SysClipY - p1.y)) | (p0.y & p1.y)) & 0x1000;
-
-   swapped = (p0.y == p1.y) & (p0.x > SysClipX);
-  }
-  //
-  // VDP1 reduces the line into a point to clip it, and it can be seen in the framebuffer under
-  // certain conditions relating to coordinate precision.
-  //
-  if(clipped)
-   p1 = p0;
-  else if(swapped)
-   std::swap(p0, p1);
- }
-
- *cycle_counter += 8;
-
- //
- //
- const int32 dx = sign_x_to_s32(13, p1.x - p0.x);
- const int32 dy = sign_x_to_s32(13, p1.y - p0.y);
- const int32 abs_dx = abs(dx); // & 0xFFF;
- const int32 abs_dy = abs(dy); // & 0xFFF;
- const int32 max_adx_ady = std::max<int32>(abs_dx, abs_dy);
- const int32 x_inc = (dx >= 0) ? 1 : -1;
- const int32 y_inc = (dy >= 0) ? 1 : -1;
- const int32 lid_x_inc = (x_inc & 0x7FF) <<  0;
- const int32 lid_y_inc = (y_inc & 0x7FF) << 16;
-
- lid.xy = (p0.x & 0x7FF) + ((p0.y & 0x7FF) << 16);
- lid.term_xy = (p1.x & 0x7FF) + ((p1.y & 0x7FF) << 16);
- lid.drawn_ac = true;	// Drawn all-clipped
- lid.color = LineData.color;
-
- //if(max_adx_ady >= 2048)
- // printf("%d,%d ->  %d, %d\n", p0.x, p0.y, p1.x, p1.y);
-
- if(GouraudEn)
-  lid.g.Setup(max_adx_ady + 1, p0.g, p1.g);
-
- if(Textured)
- {
-  LineData.ec_count = 2;	// Call before tffn()
-
-  if(MDFN_UNLIKELY(max_adx_ady < abs(p1.t - p0.t) && HSS))
-  {
-   LineData.ec_count = 0x7FFFFFFF;
-   lid.t.Setup(max_adx_ady + 1, p0.t >> 1, p1.t >> 1, 2, (bool)(FBCR & FBCR_EOS));
-  }
-  else
-   lid.t.Setup(max_adx_ady + 1, p0.t, p1.t);
-
-  lid.texel = LineData.tffn(lid.t.Current());
- }
-
- {
-  int32 aa_x_inc;
-  int32 aa_y_inc;
-
-  if(abs_dy > abs_dx)
-  {
-   if(y_inc < 0)
-   {
-    aa_x_inc =  (x_inc >> 31);
-    aa_y_inc = -(x_inc >> 31);
-   }
-   else
-   {
-    aa_x_inc = -(~x_inc >> 31);
-    aa_y_inc =  (~x_inc >> 31);
-   }
-  }
-  else
-  {
-   if(x_inc < 0)
-   {
-    aa_x_inc = -(~y_inc >> 31);
-    aa_y_inc = -(~y_inc >> 31);
-   }
-   else
-   {
-    aa_x_inc =  (y_inc >> 31);
-    aa_y_inc =  (y_inc >> 31);
-   }
-  }
-  lid.aa_xy_inc = (aa_x_inc & 0x7FF) + ((aa_y_inc & 0x7FF) << 16);
- }
-
- // x, y, x_inc, y_inc, aa_x_inc, aa_y_inc, term_x, term_y, error, error_inc, error_adj, t, g, color
- if(abs_dy > abs_dx)
- {
-  lid.error_inc =  (2 * abs_dx);
-  lid.error_adj = -(2 * abs_dy);
-  lid.error = (abs_dy - (2 * abs_dy)) - 1;
-  lid.error_cmp = 0;
-
-  if(dy < 0 && !AA)
-   lid.error_cmp--;
-
-  lid.error -= lid.error_inc;
-  lid.xy = (lid.xy + (0x8000000 - lid_y_inc)) & 0x07FF07FF;
-  lid.xy_inc[0] = lid_y_inc;
-  lid.xy_inc[1] = lid_x_inc;
- }
- else
- {
-  lid.error_inc =  (2 * abs_dy);
-  lid.error_adj = -(2 * abs_dx);
-  lid.error = (abs_dx - (2 * abs_dx)) - 1;
-  lid.error_cmp = 0;
-
-  if(dx < 0 && !AA)
-   lid.error_cmp--;
-
-  lid.error -= lid.error_inc;
-  lid.xy = (lid.xy + (0x800 - lid_x_inc)) & 0x07FF07FF;
-  lid.xy_inc[0] = lid_x_inc;
-  lid.xy_inc[1] = lid_y_inc;
- }
- if(AA)
- {
-  lid.error++;
-  lid.error_cmp++;
- }
-
- //
- lid.error_inc <<= 32 - 13;
- lid.error_adj <<= 32 - 13;
- lid.error <<= 32 - 13;
- lid.error_cmp = (uint32)lid.error_cmp << (32 - 13);
-
- return clipped;
-}
+#include "vdp1_draw.inc"
 
 void EdgeStepper::Setup(const bool gourauden, const line_vertex& p0, const line_vertex& p1, const int32 dmax)
 {
@@ -713,6 +412,20 @@ enum : int { CommandPhaseBias = __COUNTER__ + 1 };
 		 }										\
 		}										\
 
+//
+// With the render thread active, the command is replayed on the render thread's copy of the drawing state
+// while the timing-only line functions are run here.
+//
+static INLINE int32 ExecCommand(const bool resume)
+{
+ if(RenderThreadActive)
+  VDP1REND_Command(resume, TVMR, FBCR, FBDrawWhich);
+
+ if(resume)
+  return ResumeTable[CommandData[0] & 0x7](CommandData);
+ else
+  return CommandTable[CommandData[0] & 0xF](CommandData);
+}
 
 static INLINE void DoDrawing(void)
 {
@@ -731,6 +444,9 @@ static INLINE void DoDrawing(void)
    // Fetch command data
    memcpy(CommandData, &VRAM[CurCommandAddr], sizeof(CommandData));
 
+   if(RenderThreadActive)
+    VDP1REND_FetchCommand(CurCommandAddr);
+
    VDP1_EAT_CLOCKS(16);
 
    for(unsigned i = 0; i < 16; i++)
@@ -748,35 +464,14 @@ static INLINE void DoDrawing(void)
     }
     else
     {
-     static int32 (*const command_table[0xC])(const uint16* cmd_data) =
-     {
-      /* 0x0 */         /* 0x1 */           /* 0x2 */            /* 0x3 */
-      CMD_NormalSprite, CMD_ScaledSprite,   CMD_DistortedSprite, CMD_DistortedSprite,
-
-      /* 0x4 */         /* 0x5 (polyline) *//* 0x6 */            /* 0x7 (polyline) */
-      CMD_Polygon,      CMD_Line,	    CMD_Line,            CMD_Line,
-
-      /* 0x8*/          /* 0x9 */           /* 0xA */            /* 0xB */
-      CMD_SetUserClip,  CMD_SetSystemClip,  CMD_SetLocalCoord,   CMD_SetUserClip
-     };
-
-     static int32 (*const resume_table[0x8])(const uint16* cmd_data) =
-     {
-      /* 0x0 */         /* 0x1 */         /* 0x2 */            /* 0x3 */
-      RESUME_Sprite, RESUME_Sprite, RESUME_Sprite, RESUME_Sprite,
-
-      /* 0x4 */    /* 0x5 */     /* 0x6 */ /* 0x7 */
-      RESUME_Polygon, RESUME_Line, RESUME_Line, RESUME_Line,
-     };
-
-     VDP1_EAT_CLOCKS(command_table[CommandData[0] & 0xF](CommandData));
+     VDP1_EAT_CLOCKS(ExecCommand(false));
      if(!(CommandData[0] & 0x8))
      {
       for(;;)
       {
        int32 cycles;
 
-       cycles = resume_table[CommandData[0] & 0x7](CommandData);
+       cycles = ExecCommand(true);
 
        if(!cycles)
         break;
@@ -835,6 +530,9 @@ static INLINE void DoDrawing(void)
  if(MDFN_UNLIKELY(ss_horrible_hacks & HORRIBLEHACK_VDP1INSTANT))
   InstantDrawSanityLimit = CycleCounter;
 #endif
+
+ if(RenderThreadActive)
+  VDP1REND_Flush();
 }
 
 sscpu_timestamp_t Update(sscpu_timestamp_t timestamp)
@@ -970,9 +668,18 @@ void SetHBVB(const sscpu_timestamp_t event_timestamp, const bool new_hb_status,
    //
    if(!(FBCR & FBCR_FCM) || (FBManualPending && (FBCR & FBCR_FCT)))	// Swap framebuffers
    {
+    // Drawing to the outgoing framebuffer must be complete before it's displayed and erased.
+    if(RenderThreadActive)
+     VDP1REND_Sync();
+
 #if 1
     if((ss_horrible_hacks & HORRIBLEHACK_VDP1VRAM5000FIX) && DrawingActive && VRAM[0] == 0x5000 && VRAM[1] == 0x0000)
+    {
      VRAM[0] = 0x8000;
+
+     if(RenderThreadActive)
+      VDP1REND_WriteVRAM16(0, 0x8000);
+    }
 #endif
 
     if(DrawingActive)
@@ -1247,6 +954,9 @@ MDFN_FASTCALL void Write8_DB(uint32 A, uint16 DB)
   VRAMUsageWrite(A >> 1);
   SS_DBGTI(SS_DBG_VDP1_VRAMW, "[VDP1] Write to VRAM: 0x%02x->VRAM[0x%05x]", (DB >> (((A & 1) ^ 1) << 3)) & 0xFF, A);
   ne16_wbo_be<uint8>(VRAM, A, DB >> (((A & 1) ^ 1) << 3) );
+
+  if(RenderThreadActive)
+   VDP1REND_WriteVRAM8(A, DB >> (((A & 1) ^ 1) << 3));
   return;
  }
 
@@ -1259,7 +969,10 @@ MDFN_FASTCALL void Write8_DB(uint32 A, uint16 DB)
   if((TVMR & (TVMR_8BPP | TVMR_ROTATE)) == (TVMR_8BPP | TVMR_ROTATE))
    FBA = (FBA & 0x1FF) | ((FBA << 1) & 0x3FC00) | ((FBA >> 8) & 0x200);
 
-  ne16_wbo_be<uint8>(FB[FBDrawWhich], FBA & 0x3FFFF, DB >> (((A & 1) ^ 1) << 3) );
+  if(RenderThreadActive)
+   VDP1REND_WriteFB8(FBDrawWhich, FBA & 0x3FFFF, DB >> (((A & 1) ^ 1) << 3));
+  else
+   ne16_wbo_be<uint8>(FB[FBDrawWhich], FBA & 0x3FFFF, DB >> (((A & 1) ^ 1) << 3) );
   return;
  }
 
@@ -1276,6 +989,9 @@ MDFN_FASTCALL void Write16_DB(uint32 A, uint16 DB)
   VRAMUsageWrite(A >> 1);
   SS_DBGTI(SS_DBG_VDP1_VRAMW, "[VDP1] Write to VRAM: 0x%04x->VRAM[0x%05x]", DB, A);
   VRAM[A >> 1] = DB;
+
+  if(RenderThreadActive)
+   VDP1REND_WriteVRAM16(A >> 1, DB);
   return;
  }
 
@@ -1288,7 +1004,10 @@ MDFN_FASTCALL void Write16_DB(uint32 A, uint16 DB)
   if((TVMR & (TVMR_8BPP | TVMR_ROTATE)) == (TVMR_8BPP | TVMR_ROTATE))
    FBA = (FBA & 0x1FF) | ((FBA << 1) & 0x3FC00) | ((FBA >> 8) & 0x200);
 
-  FB[FBDrawWhich][(FBA >> 1) & 0x1FFFF] = DB;
+  if(RenderThreadActive)
+   VDP1REND_WriteFB16(FBDrawWhich, (FBA >> 1) & 0x1FFFF, DB);
+  else
+   FB[FBDrawWhich][(FBA >> 1) & 0x1FFFF] = DB;
   return;
  }
 
@@ -1309,6 +1028,9 @@ MDFN_FASTCALL uint16 Read16_DB(uint32 A)
   if((TVMR & (TVMR_8BPP | TVMR_ROTATE)) == (TVMR_8BPP | TVMR_ROTATE))
    FBA = (FBA & 0x1FF) | ((FBA << 1) & 0x3FC00) | ((FBA >> 8) & 0x200);
 
+  if(RenderThreadActive)
+   VDP1REND_Sync();
+
   return FB[FBDrawWhich][(FBA >> 1) & 0x1FFFF];
  }
 
@@ -1474,6 +1196,9 @@ void StateAction(StateMem* sm, const unsigned load, const bool data_only)
   SFEND
  };
 
+ if(RenderThreadActive)
+  VDP1REND_Sync();
+
  MDFNSS_StateAction(sm, load, data_only, StateRegs, "VDP1");
 
  if(load)
@@ -1501,6 +1226,9 @@ void StateAction(StateMem* sm, const unsigned load, const bool data_only)
 
   if(tmp_abs_dy_gt_abs_dx)
    std::swap(LineInnerData.xy_inc[0], LineInnerData.xy_inc[1]);
+
+  if(RenderThreadActive)
+   VDP1REND_LoadDrawState(CommandData);
  }
 }
 
@@ -1578,6 +1306,9 @@ uint32 GetRegister(const unsigned id, char* const special, const uint32 special_
 
 void SetRegister(const unsigned id, const uint32 value)
 {
+ if(RenderThreadActive)
+  VDP1REND_Sync();
+
  // TODO
  switch(id)
  {
@@ -1635,6 +1366,9 @@ void SetRegister(const unsigned id, const uint32 value)
 	break;
 */
  }
+
+ if(RenderThreadActive)
+  VDP1REND_LoadDrawState(CommandData);
 }
 
 }
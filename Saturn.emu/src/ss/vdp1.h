@@ -30,8 +30,9 @@ namespace MDFN_IEN_SS
 namespace VDP1
 {
 
-void Init(void) MDFN_COLD;
+void Init(const bool render_thread, const uint64 affinity) MDFN_COLD;
 void Kill(void) MDFN_COLD;
+void SetRenderThread(const bool enabled, const uint64 affinity = 0) MDFN_COLD;
 void StateAction(StateMem* sm, const unsigned load, const bool data_only) MDFN_COLD;
 
 void Reset(bool powering_up) MDFN_COLD;
@@ -22,6 +22,12 @@
 #ifndef __MDFN_SS_VDP1_COMMON_H
 #define __MDFN_SS_VDP1_COMMON_H
 
+#ifdef VDP1_RENDER_THREAD
+ #define VDP1_DRAW_NS VDP1::Render
+#else
+ #define VDP1_DRAW_NS VDP1
+#endif
+
 namespace MDFN_IEN_SS
 {
 
@@ -31,40 +37,18 @@ namespace VDP1
 enum : int { VDP1_SuspendResumeThreshold = 1000 };
 static_assert(VDP1_SuspendResumeThreshold >= 1, "out of acceptable range");
 
-int32 CMD_NormalSprite(const uint16*);
-int32 CMD_ScaledSprite(const uint16*);
-int32 CMD_DistortedSprite(const uint16*);
-int32 RESUME_Sprite(const uint16*);
-
-int32 CMD_Polygon(const uint16*);
-int32 RESUME_Polygon(const uint16*);
-
-int32 CMD_Polyline(const uint16*);
-int32 CMD_Line(const uint16*);
-int32 RESUME_Line(const uint16*);
-
-MDFN_HIDE extern uint16 VRAM[0x40000];
 MDFN_HIDE extern uint16 FB[2][0x20000];
-MDFN_HIDE extern uint16* FBDrawWhichPtr;
-
-MDFN_HIDE extern int32 SysClipX, SysClipY;
-MDFN_HIDE extern int32 UserClipX0, UserClipY0, UserClipX1, UserClipY1;
-MDFN_HIDE extern int32 LocalX, LocalY;
-
-MDFN_HIDE extern uint32 (MDFN_FASTCALL *const TexFetchTab[0x20])(uint32 x);
 
 constexpr unsigned TVMR_8BPP   = 0x1;
 constexpr unsigned TVMR_ROTATE = 0x2;
 constexpr unsigned TVMR_HDTV   = 0x4;
 constexpr unsigned TVMR_VBE    = 0x8;
-MDFN_HIDE extern uint8 TVMR;
 
 enum { FBCR_FCT	   = 0x01 };	// Frame buffer change trigger
 enum { FBCR_FCM	   = 0x02 };	// Frame buffer change mode
 enum { FBCR_DIL	   = 0x04 };	// Double interlace draw line(0=even, 1=odd) (does it affect drawing to FB RAM or reading from FB RAM to VDP2?)
 enum { FBCR_DIE	   = 0x08 };	// Double interlace enable
 enum { FBCR_EOS	   = 0x10 };	// Even/Odd coordinate select(0=even, 1=odd, used with HSS)
-MDFN_HIDE extern uint8 FBCR;
 
 MDFN_HIDE extern uint8 spr_w_shift_tab[8];
 MDFN_HIDE extern uint8 gouraud_lut[0x40];
@@ -204,14 +188,161 @@ struct VileTex
  int32 error_adj;
 };
 
+//
+//
+struct line_vertex
+{
+ int32 x, y;
+ uint16 g;
+ int32 t;
+};
+
+struct EdgeStepper
+{
+ void Setup(const bool gourauden, const line_vertex& p0, const line_vertex& p1, const int32 dmax);
+
+ template<bool gourauden>
+ INLINE void GetVertex(line_vertex* p)
+ {
+  p->x = x;
+  p->y = y;
+
+  if(gourauden)
+   p->g = g.Current();
+ }
+
+ template<bool gourauden>
+ INLINE void Step(void)
+ {
+  d_error += d_error_inc;
+  if((int32)d_error >= d_error_cmp)
+  {
+   d_error += d_error_adj;
+
+   x_error += x_error_inc;
+   {
+    const uint32 x_mask = -((int32)x_error >= x_error_cmp);
+    x += x_inc & x_mask;
+    x_error += x_error_adj & x_mask;
+   }
+
+   y_error += y_error_inc;
+   {
+    const uint32 y_mask = -((int32)y_error >= y_error_cmp);
+    y += y_inc & y_mask;
+    y_error += y_error_adj & y_mask;
+   }
+
+   if(gourauden)
+    g.Step();
+  }
+ }
+
+ uint32 d_error, d_error_inc, d_error_adj;
+ int32 d_error_cmp;
+
+ uint32 x, x_inc;
+ uint32 x_error, x_error_inc, x_error_adj;
+ int32 x_error_cmp;
+
+ uint32 y, y_inc;
+ uint32 y_error, y_error_inc, y_error_adj;
+ int32 y_error_cmp;
+
+ GourauderTheTerrible g;
+};
+
+struct line_inner_data
+{
+ uint32 xy;
+ uint32 error;
+ bool drawn_ac;
+
+ uint32 texel; // must be 32-bit
+ VileTex t;
+ GourauderTheTerrible g;
+ //
+ //
+ //
+ int32 xy_inc[2];
+ uint32 aa_xy_inc;
+ uint32 term_xy;
+
+ int32 error_cmp;
+ uint32 error_inc;
+ uint32 error_adj;
+
+ uint16 color;
+};
+
+struct line_data
+{
+ line_vertex p[2];
+ //
+ uint16 color;
+ int32 ec_count;
+ uint32 (MDFN_FASTCALL *tffn)(uint32);
+ uint16 CLUT[0x10];
+ uint32 cb_or;
+ uint32 tex_base;
+};
+
+struct prim_data
+{
+ EdgeStepper e[2];
+ VileTex big_t;
+ uint32 tex_base;
+ int32 iter;
+ bool need_line_resume;
+};
+}
+
+//
+// Drawing state; the optional render thread has its own copy in VDP1::Render that's kept in
+// lockstep with the main one by replaying the same commands.
+//
+namespace VDP1
+{
+#include "vdp1_state.inc"
+
+MDFN_HIDE extern bool RenderThreadActive;
+}
+
+#ifdef VDP1_RENDER_THREAD
+namespace VDP1::Render
+{
+#include "vdp1_state.inc"
+}
+#endif
+
+namespace VDP1_DRAW_NS
+{
+
+int32 CMD_NormalSprite(const uint16*);
+int32 CMD_ScaledSprite(const uint16*);
+int32 CMD_DistortedSprite(const uint16*);
+int32 RESUME_Sprite(const uint16*);
+
+int32 CMD_Polygon(const uint16*);
+int32 RESUME_Polygon(const uint16*);
+
+int32 CMD_Polyline(const uint16*);
+int32 CMD_Line(const uint16*);
+int32 RESUME_Line(const uint16*);
+
 //
 //
 //
-template<bool die, unsigned bpp8, bool MSBOn, bool UserClipEn, bool UserClipMode, bool MeshEn, bool GouraudEn, bool HalfFGEn, bool HalfBGEn>
+template<bool die, unsigned bpp8, bool MSBOn, bool UserClipEn, bool UserClipMode, bool MeshEn, bool GouraudEn, bool HalfFGEn, bool HalfBGEn, bool Plot = true>
 static INLINE int32 PlotPixel(int32 x, int32 y, uint16 pix, bool transparent, GourauderTheTerrible* g)
 {
  //printf("%d %d %d %d %d %d %d\n", bpp8, die, MeshEn, MSBOn, GouraudEn, HalfFGEn, HalfBGEn);
  static_assert(!MSBOn || (!HalfFGEn && !HalfBGEn), "Table error; sub-optimal template arguments.");
+
+ // Timing-only, for when the render thread does the actual framebuffer access
+ if(!Plot)
+  return 1 + ((MSBOn || HalfBGEn) ? 5 : 0);
+
  int32 ret = 0;
  uint16* fbyptr;
 
@@ -316,119 +447,6 @@ static INLINE int32 PlotPixel(int32 x, int32 y, uint16 pix, bool transparent, Go
 
  return ret;
 }
-//
-//
-struct line_vertex
-{
- int32 x, y;
- uint16 g;
- int32 t;
-};
-
-struct EdgeStepper
-{
- void Setup(const bool gourauden, const line_vertex& p0, const line_vertex& p1, const int32 dmax);
-
- template<bool gourauden>
- INLINE void GetVertex(line_vertex* p)
- {
-  p->x = x;
-  p->y = y;
-
-  if(gourauden)
-   p->g = g.Current();
- }
-
- template<bool gourauden>
- INLINE void Step(void)
- {
-  d_error += d_error_inc;
-  if((int32)d_error >= d_error_cmp)
-  {
-   d_error += d_error_adj;
-
-   x_error += x_error_inc;
-   {
-    const uint32 x_mask = -((int32)x_error >= x_error_cmp);
-    x += x_inc & x_mask;
-    x_error += x_error_adj & x_mask;
-   }
-
-   y_error += y_error_inc;
-   {
-    const uint32 y_mask = -((int32)y_error >= y_error_cmp);
-    y += y_inc & y_mask;
-    y_error += y_error_adj & y_mask;
-   }
-
-   if(gourauden)
-    g.Step();
-  }
- }
-
- uint32 d_error, d_error_inc, d_error_adj;
- int32 d_error_cmp;
-
- uint32 x, x_inc;
- uint32 x_error, x_error_inc, x_error_adj;
- int32 x_error_cmp;
-
- uint32 y, y_inc;
- uint32 y_error, y_error_inc, y_error_adj;
- int32 y_error_cmp;
-
- GourauderTheTerrible g;
-};
-
-struct line_inner_data
-{
- uint32 xy;
- uint32 error;
- bool drawn_ac;
-
- uint32 texel; // must be 32-bit
- VileTex t;
- GourauderTheTerrible g;
- //
- //
- //
- int32 xy_inc[2];
- uint32 aa_xy_inc;
- uint32 term_xy;
-
- int32 error_cmp;
- uint32 error_inc;
- uint32 error_adj;
-
- uint16 color;
-};
-
-struct line_data
-{
- line_vertex p[2];
- //
- uint16 color;
- int32 ec_count;
- uint32 (MDFN_FASTCALL *tffn)(uint32);
- uint16 CLUT[0x10];
- uint32 cb_or;
- uint32 tex_base;
-};
-
-MDFN_HIDE extern line_data LineData;
-
-MDFN_HIDE extern line_inner_data LineInnerData;
-
-struct prim_data
-{
- EdgeStepper e[2];
- VileTex big_t;
- uint32 tex_base;
- int32 iter;
- bool need_line_resume;
-};
-
-MDFN_HIDE extern prim_data PrimData;
 
 // Not sure the exact nature of this overhead, probably the combined effects of FBRAM and VRAM refresh, and something else.
 // 8bpp mode timing is best-caseish, performance is different between horizontal and vertical lines.
@@ -436,7 +454,6 @@ MDFN_HIDE extern prim_data PrimData;
 // Must always return 0 if 'cycles' argument is zero.
 static INLINE int32 AdjustDrawTiming(const int32 cycles)
 {
- MDFN_HIDE extern uint32 DTACounter;
  uint32 extra_cycles;
 
  DTACounter += cycles * ((TVMR & TVMR_8BPP) ? 24 : 48);
@@ -473,10 +490,10 @@ bool SetupDrawLine(int32* const cycle_counter, const bool AA, const bool Texture
 	   clipped |= !(((uclipo1 - pxy) | (pxy - uclipo0)) & 0x80008000); 				\
 	 }												\
 													\
-	 ret += PlotPixel<die, bpp8, MSBOn, UserClipEn, UserClipMode, MeshEn, GouraudEn, HalfFGEn, HalfBGEn>(px, py, pix, transparent | clipped, (GouraudEn ? &lid.g : NULL));	\
+	 ret += PlotPixel<die, bpp8, MSBOn, UserClipEn, UserClipMode, MeshEn, GouraudEn, HalfFGEn, HalfBGEn, Plot>(px, py, pix, transparent | clipped, (GouraudEn ? &lid.g : NULL));	\
 	}
 
-template<bool AA, bool Textured, bool die, unsigned bpp8, bool MSBOn, bool UserClipEn, bool UserClipMode, bool MeshEn, bool ECD, bool SPD, bool GouraudEn, bool HalfFGEn, bool HalfBGEn>
+template<bool AA, bool Textured, bool die, unsigned bpp8, bool MSBOn, bool UserClipEn, bool UserClipMode, bool MeshEn, bool ECD, bool SPD, bool GouraudEn, bool HalfFGEn, bool HalfBGEn, bool Plot = true>
 static int32 DrawLine(bool* need_line_resume)
 {
  //printf("Textured=%d, AA=%d, UserClipEn=%d, UserClipMode=%d, ECD=%d, SPD=%d, GouraudEn=%d\n", Textured, AA, UserClipEn, UserClipMode, ECD, SPD, GouraudEn);
@@ -25,7 +25,7 @@
 namespace MDFN_IEN_SS
 {
 
-namespace VDP1
+namespace VDP1_DRAW_NS
 {
 
 static int32 (*LineFuncTab[2][3][0x20][8 + 1])(bool* need_line_resume) =
@@ -70,12 +70,40 @@ static int32 (*LineFuncTab[2][3][0x20][8 + 1])(bool* need_line_resume) =
  #undef LINEFN_BC
 };
 
+#ifndef VDP1_RENDER_THREAD
+// Used while the render thread is active; only mode bits that affect draw timing are kept.
+static int32 (*LineTimingFuncTab[0x20][2][2])(bool* need_line_resume) =
+{
+ #define TIMINGFN_BSG(b, s, g)	\
+	DrawLine<false, false, false, 0, s, (bool)(b & 0x10), (b & 0x10) && (b & 0x08), false, false, false, g, false, false, false>
+
+ #define TIMINGFN_B(b) { { TIMINGFN_BSG(b, false, false), TIMINGFN_BSG(b, false, true) }, { TIMINGFN_BSG(b, true, false), TIMINGFN_BSG(b, true, true) } }
+
+ TIMINGFN_B(0x00), TIMINGFN_B(0x01), TIMINGFN_B(0x02), TIMINGFN_B(0x03),
+ TIMINGFN_B(0x04), TIMINGFN_B(0x05), TIMINGFN_B(0x06), TIMINGFN_B(0x07),
+ TIMINGFN_B(0x08), TIMINGFN_B(0x09), TIMINGFN_B(0x0A), TIMINGFN_B(0x0B),
+ TIMINGFN_B(0x0C), TIMINGFN_B(0x0D), TIMINGFN_B(0x0E), TIMINGFN_B(0x0F),
+
+ TIMINGFN_B(0x10), TIMINGFN_B(0x11), TIMINGFN_B(0x12), TIMINGFN_B(0x13),
+ TIMINGFN_B(0x14), TIMINGFN_B(0x15), TIMINGFN_B(0x16), TIMINGFN_B(0x17),
+ TIMINGFN_B(0x18), TIMINGFN_B(0x19), TIMINGFN_B(0x1A), TIMINGFN_B(0x1B),
+ TIMINGFN_B(0x1C), TIMINGFN_B(0x1D), TIMINGFN_B(0x1E), TIMINGFN_B(0x1F),
+
+ #undef TIMINGFN_B
+ #undef TIMINGFN_BSG
+};
+#endif
+
 int32 RESUME_Line(const uint16* cmd_data)
 {
  const uint16 mode = cmd_data[0x2];
  // Abusing the SPD bit passed to the line draw function to denote non-transparency when == 1, transparent when == 0.
  const bool SPD_Opaque = (((mode >> 3) & 0x7) < 0x6) ? ((int32)(TexFetchTab[(mode >> 3) & 0x1F](0xFFFFFFFF)) >= 0) : true;
- auto* const fnptr = LineFuncTab[(bool)(FBCR & FBCR_DIE)][(TVMR & TVMR_8BPP) ? ((TVMR & TVMR_ROTATE) ? 2 : 1) : 0][((mode >> 6) & 0x1E) | SPD_Opaque /*(mode >> 6) & 0x1F*/][(mode & 0x8000) ? 8 : (mode & 0x7)];
+ auto* fnptr = LineFuncTab[(bool)(FBCR & FBCR_DIE)][(TVMR & TVMR_8BPP) ? ((TVMR & TVMR_ROTATE) ? 2 : 1) : 0][((mode >> 6) & 0x1E) | SPD_Opaque /*(mode >> 6) & 0x1F*/][(mode & 0x8000) ? 8 : (mode & 0x7)];
+#ifndef VDP1_RENDER_THREAD
+ if(RenderThreadActive)
+  fnptr = LineTimingFuncTab[(mode >> 6) & 0x1F][(bool)(mode & 0x8001)][(mode & 0x8004) == 0x4];
+#endif
  const uint32 num_lines = (cmd_data[0] & 0x1) ? 4 : 1;
  uint32 iter = PrimData.iter;
  int32 ret = 0;
@@ -0,0 +1,251 @@
+/******************************************************************************/
+/* Mednafen Sega Saturn Emulation Module                                      */
+/******************************************************************************/
+/* vdp1_render.cpp:
+**  Copyright (C) 2015-2020 Mednafen Team
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+// Optional VDP1 render thread.
+//
+// The emulation thread still walks every command and line to get exact draw timing(texture end codes, clipping,
+// and the suspend/resume points all depend on it), but with the timing-only line functions that don't touch the
+// framebuffer.  The commands are replayed here by a second instance of the drawing code with its own copy of the
+// drawing state and VRAM, which does the actual pixel plotting, blending, and gouraud shading.
+//
+// The emulation thread waits for the queue to drain before a framebuffer swap, a CPU framebuffer read,
+// and anything else that needs the draw framebuffer contents or replaces the drawing state.
+
+#include "ss.h"
+#include <mednafen/mednafen.h>
+#include <mednafen/MThreading.h>
+
+#define VDP1_RENDER_THREAD
+#include "vdp1_common.h"
+#include "vdp1_render.h"
+
+#include "vdp1_line.cpp"
+#include "vdp1_poly.cpp"
+#include "vdp1_sprite.cpp"
+
+import imagine;
+
+namespace MDFN_IEN_SS
+{
+
+namespace VDP1::Render
+{
+
+uint16 VRAM[0x40000];
+uint16* FBDrawWhichPtr;
+
+int32 SysClipX, SysClipY;
+int32 UserClipX0, UserClipY0, UserClipX1, UserClipY1;
+int32 LocalX, LocalY;
+
+uint8 TVMR;
+uint8 FBCR;
+
+line_data LineData;
+line_inner_data LineInnerData;
+prim_data PrimData;
+
+uint32 DTACounter;
+
+static uint16 CommandData[0x10];
+
+static INLINE void VRAMUsageDrawRead(uint32 A) { }
+
+#include "vdp1_draw.inc"
+
+}
+
+static MThreading::Thread* RThread = NULL;
+IG::ThreadId VDP1RThreadId{};
+
+enum
+{
+ COMMAND_WRITE_VRAM8 = 0,
+ COMMAND_WRITE_VRAM16,
+ COMMAND_WRITE_FB8,
+ COMMAND_WRITE_FB16,
+
+ COMMAND_FETCH,
+ COMMAND_DRAW,
+ COMMAND_RESUME,
+
+ COMMAND_EXIT
+};
+
+struct WQ_Entry
+{
+ uint16 Command;
+ uint16 Arg16;
+ uint32 Arg32;
+};
+
+static IG::RingBuffer<WQ_Entry, {.fixedSize = 0x4000}> WQ;
+
+static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
+{
+ WQ.push({command, arg16, arg32}, {.blocking = true, .flushSize = 64});
+}
+
+static int RThreadEntry(void* data)
+{
+ using namespace VDP1::Render;
+
+ for(;;)
+ {
+  // Entries are processed in place so VDP1REND_Sync() doesn't return until the last one is finished.
+  auto span = WQ.beginRead(1, {.blocking = true});
+
+  if(span.empty())
+   continue;
+
+  const WQ_Entry* wqe = span.data();
+
+  switch(wqe->Command)
+  {
+   case COMMAND_WRITE_VRAM8:
+	ne16_wbo_be<uint8>(VRAM, wqe->Arg32, wqe->Arg16);
+	break;
+
+   case COMMAND_WRITE_VRAM16:
+	VRAM[wqe->Arg32] = wqe->Arg16;
+	break;
+
+   case COMMAND_WRITE_FB8:
+	ne16_wbo_be<uint8>(VDP1::FB[wqe->Arg32 >> 18], wqe->Arg32 & 0x3FFFF, wqe->Arg16);
+	break;
+
+   case COMMAND_WRITE_FB16:
+	VDP1::FB[wqe->Arg32 >> 17][wqe->Arg32 & 0x1FFFF] = wqe->Arg16;
+	break;
+
+   case COMMAND_FETCH:
+	memcpy(CommandData, &VRAM[wqe->Arg32], sizeof(CommandData));
+	break;
+
+   case COMMAND_DRAW:
+   case COMMAND_RESUME:
+	TVMR = wqe->Arg16 & 0xFF;
+	FBCR = wqe->Arg16 >> 8;
+	FBDrawWhichPtr = VDP1::FB[wqe->Arg32];
+
+	if(wqe->Command == COMMAND_RESUME)
+	 ResumeTable[CommandData[0] & 0x7](CommandData);
+	else
+	 CommandTable[CommandData[0] & 0xF](CommandData);
+	break;
+
+   case COMMAND_EXIT:
+	WQ.endRead(span);
+	WQ.notifyRead();
+	return 0;
+  }
+
+  WQ.endRead(span);
+  WQ.notifyRead();
+ }
+}
+
+void VDP1REND_Init(const uint64 affinity)
+{
+ WQ.clear();
+ RThread = MThreading::Thread_Create(RThreadEntry, NULL, "MDFN VDP1 Render");
+ VDP1RThreadId = MThreading::Thread_ID(RThread);
+ if(affinity)
+  MThreading::Thread_SetAffinity(RThread, affinity);
+}
+
+void VDP1REND_Kill(void)
+{
+ if(RThread != NULL)
+ {
+  WWQ(COMMAND_EXIT);
+  WQ.notifyWrite();
+  MThreading::Thread_Wait(RThread, NULL);
+  RThread = NULL;
+  VDP1RThreadId = {};
+ }
+}
+
+// Call only with the queue drained.
+void VDP1REND_LoadDrawState(const uint16* cmd_data)
+{
+ memcpy(VDP1::Render::VRAM, VDP1::VRAM, sizeof(VDP1::Render::VRAM));
+ memcpy(VDP1::Render::CommandData, cmd_data, sizeof(VDP1::Render::CommandData));
+
+ VDP1::Render::SysClipX = VDP1::SysClipX;
+ VDP1::Render::SysClipY = VDP1::SysClipY;
+ VDP1::Render::UserClipX0 = VDP1::UserClipX0;
+ VDP1::Render::UserClipY0 = VDP1::UserClipY0;
+ VDP1::Render::UserClipX1 = VDP1::UserClipX1;
+ VDP1::Render::UserClipY1 = VDP1::UserClipY1;
+ VDP1::Render::LocalX = VDP1::LocalX;
+ VDP1::Render::LocalY = VDP1::LocalY;
+
+ VDP1::Render::LineData = VDP1::LineData;
+ VDP1::Render::LineData.tffn = NULL;	// Set from the render instance's TexFetchTab on resume.
+ VDP1::Render::LineInnerData = VDP1::LineInnerData;
+ VDP1::Render::PrimData = VDP1::PrimData;
+
+ VDP1::Render::DTACounter = VDP1::DTACounter;
+}
+
+void VDP1REND_Sync(void)
+{
+ WQ.waitForSize(0);
+}
+
+void VDP1REND_Flush(void)
+{
+ WQ.notifyWrite();
+}
+
+// VRAM writes are queued in order, so this fetches the same command data as the emulation thread did.
+void VDP1REND_FetchCommand(uint32 A)
+{
+ WWQ(COMMAND_FETCH, A);
+}
+
+void VDP1REND_Command(const bool resume, const uint8 tvmr, const uint8 fbcr, const bool fb_draw_which)
+{
+ WWQ(resume ? COMMAND_RESUME : COMMAND_DRAW, fb_draw_which, tvmr | (fbcr << 8));
+}
+
+void VDP1REND_WriteVRAM8(uint32 A, uint8 V)
+{
+ WWQ(COMMAND_WRITE_VRAM8, A, V);
+}
+
+void VDP1REND_WriteVRAM16(uint32 A, uint16 V)
+{
+ WWQ(COMMAND_WRITE_VRAM16, A, V);
+}
+
+void VDP1REND_WriteFB8(const bool which, uint32 A, uint8 V)
+{
+ WWQ(COMMAND_WRITE_FB8, (which << 18) | A, V);
+}
+
+void VDP1REND_WriteFB16(const bool which, uint32 A, uint16 V)
+{
+ WWQ(COMMAND_WRITE_FB16, (which << 17) | A, V);
+}
+
+}
@@ -0,0 +1,44 @@
+/******************************************************************************/
+/* Mednafen Sega Saturn Emulation Module                                      */
+/******************************************************************************/
+/* vdp1_render.h:
+**  Copyright (C) 2015-2020 Mednafen Team
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software Foundation, Inc.,
+** 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef __MDFN_SS_VDP1_RENDER_H
+#define __MDFN_SS_VDP1_RENDER_H
+
+namespace MDFN_IEN_SS
+{
+
+void VDP1REND_Init(const uint64 affinity) MDFN_COLD;
+void VDP1REND_Kill(void) MDFN_COLD;
+void VDP1REND_LoadDrawState(const uint16* cmd_data) MDFN_COLD;
+void VDP1REND_Sync(void);
+void VDP1REND_Flush(void);
+
+void VDP1REND_FetchCommand(uint32 A);
+void VDP1REND_Command(const bool resume, const uint8 tvmr, const uint8 fbcr, const bool fb_draw_which);
+
+void VDP1REND_WriteVRAM8(uint32 A, uint8 V) MDFN_HOT;
+void VDP1REND_WriteVRAM16(uint32 A, uint16 V) MDFN_HOT;
+void VDP1REND_WriteFB8(const bool which, uint32 A, uint8 V) MDFN_HOT;
+void VDP1REND_WriteFB16(const bool which, uint32 A, uint16 V) MDFN_HOT;
+
+}
+
+#endif
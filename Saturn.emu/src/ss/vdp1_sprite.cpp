@@ -27,10 +27,10 @@
 namespace MDFN_IEN_SS
 {
 
-namespace VDP1
+namespace VDP1_DRAW_NS
 {
 
-static int32 (*LineFuncTab[2][3][0x20][8 + 1])(bool* need_line_resume) =
+static int32 (*SpriteLineFuncTab[2][3][0x20][8 + 1])(bool* need_line_resume) =
 {
  #define LINEFN_BC(die, bpp8, b, c)	\
 	DrawLine<true, true, die, bpp8, c == 0x8, (bool)(b & 0x10), (b & 0x10) && (b & 0x08), (bool)(b & 0x04), (bool)(b & 0x02), (bool)(b & 0x01), (bool)(c & 0x4), (!bpp8) && (c & 0x2), (bool)(c & 0x1)>
@@ -72,6 +72,30 @@ static int32 (*LineFuncTab[2][3][0x20][8 + 1])(bool* need_line_resume) =
  #undef LINEFN_BC
 };
 
+#ifndef VDP1_RENDER_THREAD
+// Used while the render thread is active; only mode bits that affect draw timing are kept.
+static int32 (*SpriteTimingFuncTab[0x20][2][2])(bool* need_line_resume) =
+{
+ #define TIMINGFN_BSG(b, s, g)	\
+	DrawLine<true, true, false, 0, s, (bool)(b & 0x10), (b & 0x10) && (b & 0x08), false, (bool)(b & 0x02), false, g, false, false, false>
+
+ #define TIMINGFN_B(b) { { TIMINGFN_BSG(b, false, false), TIMINGFN_BSG(b, false, true) }, { TIMINGFN_BSG(b, true, false), TIMINGFN_BSG(b, true, true) } }
+
+ TIMINGFN_B(0x00), TIMINGFN_B(0x01), TIMINGFN_B(0x02), TIMINGFN_B(0x03),
+ TIMINGFN_B(0x04), TIMINGFN_B(0x05), TIMINGFN_B(0x06), TIMINGFN_B(0x07),
+ TIMINGFN_B(0x08), TIMINGFN_B(0x09), TIMINGFN_B(0x0A), TIMINGFN_B(0x0B),
+ TIMINGFN_B(0x0C), TIMINGFN_B(0x0D), TIMINGFN_B(0x0E), TIMINGFN_B(0x0F),
+
+ TIMINGFN_B(0x10), TIMINGFN_B(0x11), TIMINGFN_B(0x12), TIMINGFN_B(0x13),
+ TIMINGFN_B(0x14), TIMINGFN_B(0x15), TIMINGFN_B(0x16), TIMINGFN_B(0x17),
+ TIMINGFN_B(0x18), TIMINGFN_B(0x19), TIMINGFN_B(0x1A), TIMINGFN_B(0x1B),
+ TIMINGFN_B(0x1C), TIMINGFN_B(0x1D), TIMINGFN_B(0x1E), TIMINGFN_B(0x1F),
+
+ #undef TIMINGFN_B
+ #undef TIMINGFN_BSG
+};
+#endif
+
 enum
 {
  FORMAT_NORMAL = 0,
@@ -83,7 +107,11 @@ template<bool gourauden>
 static int32 SpriteResumeBase(const uint16* cmd_data)
 {
  const uint16 mode = cmd_data[0x2];
- auto* fnptr = LineFuncTab[(bool)(FBCR & FBCR_DIE)][(TVMR & TVMR_8BPP) ? ((TVMR & TVMR_ROTATE) ? 2 : 1) : 0][(mode >> 6) & 0x1F][(mode & 0x8000) ? 8 : (mode & 0x7)];
+ auto* fnptr = SpriteLineFuncTab[(bool)(FBCR & FBCR_DIE)][(TVMR & TVMR_8BPP) ? ((TVMR & TVMR_ROTATE) ? 2 : 1) : 0][(mode >> 6) & 0x1F][(mode & 0x8000) ? 8 : (mode & 0x7)];
+#ifndef VDP1_RENDER_THREAD
+ if(RenderThreadActive)
+  fnptr = SpriteTimingFuncTab[(mode >> 6) & 0x1F][(bool)(mode & 0x8001)][(mode & 0x8004) == 0x4];
+#endif
  LineData.tffn = TexFetchTab[(mode >> 3) & 0x1F];
  //
  //
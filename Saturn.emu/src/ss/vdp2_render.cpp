@@ -3220,8 +3220,6 @@ static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
 
 static int RThreadEntry(void* data)
 {
- RThreadId = IG::thisThreadId();
-
  auto nextCommand = []() { return WQ.pop({.blocking = true}); };
  for(WQ_Entry entry = nextCommand(); entry.Command != COMMAND_EXIT; entry = nextCommand())
  {
@@ -3277,6 +3275,7 @@ void VDP2REND_Init(const bool IsPAL, const uint64 affinity)
  //
  WQ.clear();
  RThread = MThreading::Thread_Create(RThreadEntry, NULL, "MDFN VDP2 Render");
+ RThreadId = MThreading::Thread_ID(RThread);
  if(affinity)
   MThreading::Thread_SetAffinity(RThread, affinity);
 }
@@ -6,6 +6,7 @@
 #include <apu/apu.h>
 #include <apu/bapu/snes/snes.hpp>
 #include <ppu.h>
+#include <gfx.h>
 #endif
 import system;
 import emuex;
@@ -55,6 +56,29 @@ public:
 		item.emplace_back(&dspInterpolation);
 	}
 };
+
+class CustomSystemOptionView : public SystemOptionView, public MainAppHelper
+{
+	using MainAppHelper::system;
+
+	BoolMenuItem renderThread
+	{
+		"Threaded Video Rendering", attachParams(),
+		(bool)system().optionRenderThread,
+		[this](BoolMenuItem &item)
+		{
+			system().optionRenderThread = item.flipBoolValue(*this);
+			S9xSetRenderThread(system().optionRenderThread);
+		}
+	};
+
+public:
+	CustomSystemOptionView(ViewAttachParams attach): SystemOptionView{attach, true}
+	{
+		loadStockItems();
+		item.emplace_back(&renderThread);
+	}
+};
 #endif
 
 class ConsoleOptionView : public TableView, public MainAppHelper
@@ -619,6 +643,7 @@ std::unique_ptr<View> EmuApp::makeCustomView(ViewAttachParams attach, ViewID id)
 	{
 		#ifndef SNES9X_VERSION_1_4
 		case ViewID::AUDIO_OPTIONS: return std::make_unique<CustomAudioOptionView>(attach, audio);
+		case ViewID::SYSTEM_OPTIONS: return std::make_unique<CustomSystemOptionView>(attach);
 		#endif
 		case ViewID::FILE_PATH_OPTIONS: return std::make_unique<CustomFilePathOptionView>(attach);
 		case ViewID::SYSTEM_ACTIONS: return std::make_unique<CustomSystemActionsView>(attach);
@@ -392,6 +392,24 @@ bool8 S9xDoScreenshot(int, int) { return 1; }
 void S9xSyncSpeed() {}
 bool8 S9xInitUpdate() { return 1; }
 
+#ifndef SNES9X_VERSION_1_4
+static ThreadId renderThreadId{};
+
+void S9xRenderThreadInit() { renderThreadId = thisThreadId(); }
+void S9xRenderThreadDeinit() { renderThreadId = {}; }
+
+namespace EmuEx
+{
+
+void Snes9xSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
+{
+	if(optionRenderThread && renderThreadId)
+		ids.emplace_back(renderThreadId);
+}
+
+}
+#endif
+
 void notifyBackupMemoryWritten()
 {
 	EmuEx::gSystem().onBackupMemoryWritten();
@@ -7,6 +7,7 @@ module;
 #include <apu/apu.h>
 #include <apu/bapu/snes/snes.hpp>
 #include <ppu.h>
+#include <gfx.h>
 #endif
 
 module system;
@@ -27,6 +28,7 @@ void Snes9xSystem::onOptionsLoaded()
 {
 	#ifndef SNES9X_VERSION_1_4
 	SNES::dsp.spc_dsp.interpolation = optionAudioDSPInterpolation;
+	S9xSetRenderThread(optionRenderThread);
 	#endif
 }
 
@@ -38,6 +40,7 @@ bool Snes9xSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 		{
 			#ifndef SNES9X_VERSION_1_4
 			case CFGKEY_AUDIO_DSP_INTERPOLATON: return readOptionValue(io, optionAudioDSPInterpolation);
+			case CFGKEY_RENDER_THREAD: return readOptionValue(io, optionRenderThread);
 			#endif
 			case CFGKEY_CHEATS_PATH: return readStringOptionValue(io, cheatsDir);
 			case CFGKEY_PATCHES_PATH: return readStringOptionValue(io, patchesDir);
@@ -71,6 +74,7 @@ void Snes9xSystem::writeConfig(ConfigType type, FileIO &io)
 	{
 		#ifndef SNES9X_VERSION_1_4
 		writeOptionValueIfNotDefault(io, optionAudioDSPInterpolation);
+		writeOptionValueIfNotDefault(io, optionRenderThread);
 		#endif
 		writeStringOptionValue(io, CFGKEY_CHEATS_PATH, cheatsDir);
 		writeStringOptionValue(io, CFGKEY_PATCHES_PATH, patchesDir);
@@ -13,6 +13,8 @@
 #include "movie.h"
 #include "screenshot.h"
 #include "display.h"
+#include <thread>
+import imagine;
 
 extern struct SCheatData		Cheat;
 
@@ -21,6 +23,7 @@ void S9xComputeClipWindows (void);
 void (*S9xCustomDisplayString) (const char *, int, int, bool, int) = NULL;
 
 static void SetupOBJ (void);
+static void QueueUpdateScreen (void);
 static void DrawOBJS (int);
 static void DisplayTime (void);
 static void DisplayFrameRate (void);
@@ -38,6 +41,7 @@ static uint16 get_crosshair_color (uint8);
 static void S9xDisplayStringType (const char *, int, int, bool, int);
 
 #define TILE_PLUS(t, x)	(((t) & 0xfc00) | ((t + x) & 0x3ff))
+#define RENDER_THREAD_MIN_LINES	8 // hand off at least a tile row to amortize waking the render thread
 
 
 bool8 S9xGraphicsInit (void)
@@ -268,6 +272,9 @@ void RenderLine (uint8 C)
 		}
 
 		IPPU.CurrentLine = C + 1;
+
+		if (IPPU.CurrentLine - IPPU.PreviousLine >= RENDER_THREAD_MIN_LINES)
+			QueueUpdateScreen();
 	}
 	else
 	{
@@ -407,17 +414,33 @@ static inline void RenderScreen (bool8 sub)
 	DrawBackdrop();
 }
 
-void S9xUpdateScreen (void)
+// Emulation side of a screen update that advances the rendered line range,
+// the last end line is kept here since GFX may be in use by the render thread
+static uint32	LastEndY;
+
+static void BeginUpdateScreen (uint32 &StartY, uint32 &EndY)
 {
 	if (IPPU.OBJChanged || IPPU.InterlaceOBJ)
+	{
+		S9xWaitForRender();
 		SetupOBJ();
+	}
 
 	// XXX: Check ForceBlank? Or anything else?
-	PPU.RangeTimeOver |= GFX.OBJLines[GFX.EndY].RTOFlags;
+	PPU.RangeTimeOver |= GFX.OBJLines[LastEndY].RTOFlags;
 
-	GFX.StartY = IPPU.PreviousLine;
-	if ((GFX.EndY = IPPU.CurrentLine - 1) >= PPU.ScreenHeight)
-		GFX.EndY = PPU.ScreenHeight - 1;
+	StartY = IPPU.PreviousLine;
+	if ((EndY = IPPU.CurrentLine - 1) >= PPU.ScreenHeight)
+		EndY = PPU.ScreenHeight - 1;
+
+	LastEndY = EndY;
+	IPPU.PreviousLine = IPPU.CurrentLine;
+}
+
+static void RenderLines (uint32 StartY, uint32 EndY)
+{
+	GFX.StartY = StartY;
+	GFX.EndY = EndY;
 
 	if (!PPU.ForcedBlanking)
 	{
@@ -480,10 +503,89 @@ void S9xUpdateScreen (void)
 			for (int x = 0; x < IPPU.RenderedScreenWidth; x++)
 				GFX.S[x] = black;
 	}
+}
 
-	IPPU.PreviousLine = IPPU.CurrentLine;
+void S9xUpdateScreen (void)
+{
+	uint32	StartY, EndY;
+
+	S9xWaitForRender();
+	BeginUpdateScreen(StartY, EndY);
+	RenderLines(StartY, EndY);
+}
+
+// Render thread, draws line ranges handed off by RenderLine() while the CPUs keep running.
+// Every PPU change that affects rendering already calls FLUSH_REDRAW() first, which waits
+// for the thread before the change is made, so output matches rendering on the CPU thread.
+
+std::atomic_bool	RenderThreadBusy;
+static std::thread	RenderThread;
+static bool8		RenderThreadQuit;
+static uint32		RenderThreadStartY, RenderThreadEndY;
+
+static void RenderThreadMain (void)
+{
+	for (;;)
+	{
+		RenderThreadBusy.wait(false, std::memory_order_acquire);
+		if (RenderThreadQuit)
+			return;
+
+		RenderLines(RenderThreadStartY, RenderThreadEndY);
+		RenderThreadBusy.store(false, std::memory_order_release);
+		RenderThreadBusy.notify_one();
+	}
+}
+
+static void QueueUpdateScreen (void)
+{
+	if (!RenderThread.joinable() || RenderThreadBusy.load(std::memory_order_acquire))
+		return;
+
+	BeginUpdateScreen(RenderThreadStartY, RenderThreadEndY);
+	RenderThreadBusy.store(true, std::memory_order_release);
+	RenderThreadBusy.notify_one();
+}
+
+void S9xFinishRender (void)
+{
+	while (RenderThreadBusy.load(std::memory_order_acquire))
+		RenderThreadBusy.wait(true, std::memory_order_acquire);
+}
+
+void S9xSetRenderThread (bool8 enable)
+{
+	if ((bool) enable == RenderThread.joinable())
+		return;
+
+	if (enable)
+	{
+		// the port's thread ID is set before this returns so it's never stale
+		RenderThread = IG::makeThreadSync([](auto &sem)
+		{
+			S9xRenderThreadInit();
+			sem.release();
+			RenderThreadMain();
+		});
+	}
+	else
+	{
+		S9xFinishRender();
+		RenderThreadQuit = TRUE;
+		RenderThreadBusy.store(true, std::memory_order_release);
+		RenderThreadBusy.notify_one();
+		RenderThread.join();
+		RenderThreadBusy.store(false, std::memory_order_relaxed);
+		RenderThreadQuit = FALSE;
+		S9xRenderThreadDeinit();
+	}
 }
 
+static struct RenderThreadExit
+{
+	~RenderThreadExit() { S9xSetRenderThread(FALSE); }
+} renderThreadExit;
+
 static void SetupOBJ (void)
 {
 	int	SmallWidth, SmallHeight, LargeWidth, LargeHeight;
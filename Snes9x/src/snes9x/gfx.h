@@ -8,6 +8,7 @@
 #define _GFX_H_
 
 #include "port.h"
+#include <atomic>
 #include <vector>
 
 struct SLineData
@@ -204,6 +205,8 @@ struct COLOR_SUB
 
 void S9xStartScreenRefresh (void);
 void S9xEndScreenRefresh (void);
+void S9xSetRenderThread (bool8);
+void S9xFinishRender (void);
 void S9xBuildDirectColourMaps (void);
 void RenderLine (uint8);
 void S9xComputeClipWindows (void);
@@ -212,7 +215,19 @@ void S9xGraphicsScreenResize (void);
 // called automatically unless Settings.AutoDisplayMessages is false
 void S9xDisplayMessages (uint16 *, int, int, int, int);
 
+// set while the render thread is drawing a range of lines queued by RenderLine()
+extern std::atomic_bool	RenderThreadBusy;
+
+// must be called before modifying any state the renderer reads
+static inline void S9xWaitForRender (void)
+{
+	if (RenderThreadBusy.load(std::memory_order_acquire))
+		S9xFinishRender();
+}
+
 // external port interface which must be implemented or initialised for each port
+void S9xRenderThreadInit (void);
+void S9xRenderThreadDeinit (void);
 bool8 S9xGraphicsInit (void);
 void S9xGraphicsDeinit (void);
 bool8 S9xInitUpdate (void);
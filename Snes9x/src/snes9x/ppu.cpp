@@ -852,6 +852,9 @@ void S9xSetPPU (uint8 Byte, uint16 Address)
 			case 0x2133: // SETINI
 				if (Byte != Memory.FillRAM[0x2133])
 				{
+					// screen height & mode 7 EXTBG change without a redraw
+					S9xWaitForRender();
+
 					if ((Memory.FillRAM[0x2133] ^ Byte) & 8)
 					{
 						FLUSH_REDRAW();
@@ -237,6 +237,7 @@ extern const SnesModel	M2SNES;
 void S9xUpdateScreen (void);
 static inline void FLUSH_REDRAW (void)
 {
+	S9xWaitForRender();
 	if (IPPU.PreviousLine != IPPU.CurrentLine)
 		S9xUpdateScreen();
 }
@@ -350,6 +351,7 @@ static bool CHECK_INBLANK1(SPPU &PPU, const SCPUState &CPU)
 			return true;
 		}
 	}
+	S9xWaitForRender();
 	return false;
 }
 #else
@@ -360,6 +362,7 @@ static bool CHECK_INBLANK1(SPPU &PPU, const SCPUState &CPU)
 		PPU.VMA.Address += !PPU.VMA.High ? PPU.VMA.Increment : 0;
 		return true;
 	}
+	S9xWaitForRender();
 	return false;
 }
 #endif
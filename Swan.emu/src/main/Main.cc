@@ -52,6 +52,8 @@ FS::FileString WsSystem::stateFilename(int slot, std::string_view name) const
 size_t WsSystem::stateSize() { return stateSizeMDFN(); }
 void WsSystem::readState(EmuApp&, std::span<uint8_t> buff) { readStateMDFN(buff); }
 size_t WsSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
+void WsSystem::readStateStream(EmuApp&, IO &io) { readStateStreamMDFN(io); }
+void WsSystem::writeStateStream(IO &io) { writeStateStreamMDFN(io); }
 
 void WsSystem::loadBackupMemory(EmuApp &app)
 {
@@ -122,7 +124,7 @@ void WsSystem::configAudioRate(FrameRate outputFrameRate, int outputRate)
 void WsSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	static constexpr size_t maxAudioFrames = 48000 / AppMeta::minFrameRate;
-	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
+	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames, {.renderToVideoImage = true});
 	if(configuredLCDVTotal != lcdVTotal()) [[unlikely]]
 	{
 		onFrameRateChanged();
@@ -141,7 +143,7 @@ extern "C++" namespace Mednafen
 
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
 {
-	espec->video->startFrameWithFormat(espec->taskCtx, static_cast<EmuEx::WsSystem&>(*espec->sys).mSurfacePix);
+	EmuEx::commitVideoFrame(*espec, static_cast<EmuEx::WsSystem&>(*espec->sys).mSurfacePix);
 }
 
 }
@@ -238,6 +238,10 @@ public:
 	void flushSystemInputEvents();
 	void flushInternalInputEvents();
 	bool hasInputDeviceHotSwap() const;
+	bool setInputThread(bool on);
+	bool hasInputThread() const;
+	void setQueuedKeyEventHandler(QueuedKeyEventDelegate);
+	void dispatchQueuedInputEvents();
 
 	// App exit
 	void exit(int returnVal);
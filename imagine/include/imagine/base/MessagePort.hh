@@ -17,11 +17,19 @@
 
 #include <imagine/config/defs.hh>
 #include <imagine/base/Pipe.hh>
+#include <imagine/base/CustomEvent.hh>
 #include <imagine/thread/Semaphore.hh>
+#include <imagine/util/DelegateFunc.hh>
 #include <imagine/util/concepts.hh>
 #include <imagine/util/utility.hh>
+#include <imagine/logger/SystemLogger.hh>
 #ifndef IG_USE_MODULE_STD
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
 #include <cstring>
+#include <memory>
 #include <span>
 #include <string_view>
 #include <utility>
@@ -40,7 +48,10 @@ enum class MessageReplyMode
 };
 
 template<class MsgType>
-class PipeMessages
+class RingMessagePort;
+
+template<class MsgType>
+class RingMessages
 {
 public:
 	struct Sentinel {};
@@ -48,26 +59,26 @@ public:
 	class Iterator
 	{
 	public:
-		constexpr Iterator(PosixIO &io): io{&io}
+		constexpr Iterator(RingMessagePort<MsgType> &port): port{&port}
 		{
 			this->operator++();
 		}
 
 		Iterator operator++()
 		{
-			if(!io) [[unlikely]]
+			if(!port) [[unlikely]]
 				return *this;
-			if(io->read(msg).bytes != sizeof(MsgType))
+			if(!port->readNextMessage(msg))
 			{
 				// end of messages
-				io = nullptr;
+				port = nullptr;
 			}
 			return *this;
 		}
 
 		bool operator==(Sentinel) const
 		{
-			return !io;
+			return !port;
 		}
 
 		const MsgType &operator*() const
@@ -76,40 +87,57 @@ public:
 		}
 
 	private:
-		PosixIO *io{};
+		RingMessagePort<MsgType> *port{};
 		MsgType msg;
 	};
 
-	constexpr PipeMessages(PosixIO &io): io{io} {}
-	auto begin() const { return Iterator{io}; }
+	constexpr RingMessages(RingMessagePort<MsgType> &port): port{port} {}
+	auto begin() const { return Iterator{port}; }
 	auto end() const { return Sentinel{}; }
 
 	template <class T>
 	T getExtraData()
 	{
-		return io.get<T>();
+		T obj;
+		readExtraData(std::span<T>{&obj, 1});
+		return obj;
 	}
 
 	template <class T>
-	auto readExtraData(std::span<T> span)
+	size_t readExtraData(std::span<T> span)
 	{
-		return io.read(span);
+		return port.readExtraData(span.data(), span.size_bytes());
 	}
 
 protected:
-	PosixIO &io;
+	RingMessagePort<MsgType> &port;
 };
 
+// Multi-producer, single-consumer message port using a lock-free ring of fixed size slots.
+// Senders reserve contiguous slots with a CAS on the write position, so a message and its
+// extra data always stay together, and only the first send after the consumer catches up
+// signals the event fd, or the consumer's atomic wait when no event loop is attached.
+// A handler that stops iterating early leaves the remaining messages for the next notification.
 template<class MsgType>
-class PipeMessagePort
+class RingMessagePort
 {
 public:
-	using Messages = PipeMessages<MsgType>;
+	using Messages = RingMessages<MsgType>;
+	using MessagesDelegate = DelegateFunc<bool(Messages)>;
 	static constexpr size_t MSG_SIZE = sizeof(MsgType);
-	static_assert(MSG_SIZE < PIPE_BUF, "size of message too big for atomic writes");
 
-	PipeMessagePort(std::string_view debugLabel = {}, int capacity = 0):
-		pipe{debugLabel, (int)MSG_SIZE * capacity} {}
+	RingMessagePort(std::string_view debugLabel = {}, int capacity = 0):
+		event{{.debugLabel = debugLabel}, [this]{ runHandler(); }},
+		// hold at least as many bytes as a default sized pipe
+		slots{uint32_t(std::bit_ceil(std::max(size_t(capacity), 0x10000 / slotSize)))},
+		seqs{std::make_unique<std::atomic_uint32_t[]>(slots)},
+		data{std::make_unique_for_overwrite<uint8_t[]>(slots * slotSize)}
+	{
+		for(uint32_t i = 0; i < slots; i++)
+		{
+			seqs[i].store(i, std::memory_order_relaxed);
+		}
+	}
 
 	void attach(auto &&f)
 	{
@@ -118,35 +146,26 @@ public:
 
 	void attach(EventLoop loop, Callable<void, Messages> auto &&f)
 	{
-		pipe.setReadNonBlocking(true);
-		pipe.attach(loop,
-			[=](auto &io) -> bool
-			{
-				Messages msg{io};
-				f(msg);
-				return true;
-			});
+		attach(loop, MessagesDelegate{[=](Messages msgs){ f(msgs); return true; }});
 	}
 
 	void attach(EventLoop loop, Callable<bool, Messages> auto &&f)
 	{
-		pipe.setReadNonBlocking(true);
-		pipe.attach(loop,
-			[=](auto &io) -> bool
-			{
-				Messages msg{io};
-				return f(msg);
-			});
+		onMessages = f;
+		useEvent.store(true);
+		event.attach(loop);
+		// handle anything sent before attaching, a sender that saw useEvent unset only notified the atomic
+		event.notify();
 	}
 
 	void detach()
 	{
-		pipe.detach();
+		event.detach();
 	}
 
 	bool send(MsgType msg)
 	{
-		return pipe.sink().put(msg) != -1;
+		return write(msg, nullptr, 0);
 	}
 
 	bool send(MsgType msg, MessageReplyMode mode)
@@ -167,7 +186,7 @@ public:
 		if(semPtr)
 		{
 			msg.setReplySemaphore(semPtr);
-			if(pipe.sink().put(msg) == -1) [[unlikely]]
+			if(!send(msg)) [[unlikely]]
 			{
 				return false;
 			}
@@ -182,44 +201,219 @@ public:
 
 	bool sendWithExtraData(MsgType msg, auto &&obj)
 	{
-		static_assert(MSG_SIZE + sizeof(obj) < PIPE_BUF, "size of data too big for atomic writes");
 		return sendWithExtraData(msg, std::span<const std::remove_reference_t<decltype(obj)>>{&obj, 1});
 	}
 
 	template <class T>
 	bool sendWithExtraData(MsgType msg, std::span<const T> span)
 	{
-		if(span.empty())
-			return send(msg);
-		assume(span.size_bytes() < PIPE_BUF);
-		OutVector buffs[2]{std::span<const MsgType>{&msg, 1}, span};
-		return pipe.sink().writeVector(buffs) != -1;
+		return write(msg, span.data(), span.size_bytes());
 	}
 
-	MsgType getMessage() { return pipe.source().get<MsgType>(); }
+	MsgType getMessage()
+	{
+		MsgType msg{};
+		readNextMessage(msg, false);
+		return msg;
+	}
 
 	void clear()
 	{
-		while(getMessage()) {}
+		MsgType msg;
+		while(readNextMessage(msg, false)) {}
 	}
 
 	void dispatchMessages()
 	{
-		pipe.dispatchSourceEvents();
+		if(hasMessage())
+			runHandler();
 	}
 
-	Messages messages() { return Messages{pipe.source()}; }
+	Messages messages() { return Messages{*this}; }
 
-	explicit operator bool() const { return (bool)pipe; }
+	explicit operator bool() const { return (bool)event; }
 
 protected:
-	Pipe pipe;
+	struct RecordHeader
+	{
+		uint32_t slots;
+	};
+
+	static constexpr size_t slotSize = (sizeof(RecordHeader) + MSG_SIZE + 7) & ~size_t(7);
+
+	static constexpr SystemLogger log{"MessagePort"};
+
+	CustomEvent event;
+	MessagesDelegate onMessages;
+	const uint32_t slots;
+	std::unique_ptr<std::atomic_uint32_t[]> seqs;
+	std::unique_ptr<uint8_t[]> data;
+	alignas(64) std::atomic_uint32_t writePos{};
+	std::atomic_uint32_t waitingWriters{};
+	alignas(64) std::atomic_bool isNotified{};
+	std::atomic_bool useEvent{};
+	// consumer state
+	alignas(64) uint32_t readPos{};
+	uint32_t recordEnd{};
+	size_t extraDataOffset{};
+
+	friend Messages;
+	friend typename Messages::Iterator;
+
+	uint32_t mask() const { return slots - 1; }
+	size_t dataSize() const { return size_t(slots) * slotSize; }
+	size_t dataOffset(uint32_t pos) const { return size_t(pos & mask()) * slotSize; }
+
+	void copyIn(size_t offset, const void *src, size_t size)
+	{
+		auto firstSize = std::min(size, dataSize() - offset);
+		std::memcpy(&data[offset], src, firstSize);
+		std::memcpy(&data[0], static_cast<const uint8_t*>(src) + firstSize, size - firstSize);
+	}
+
+	void copyOut(size_t offset, void *dest, size_t size) const
+	{
+		auto firstSize = std::min(size, dataSize() - offset);
+		std::memcpy(dest, &data[offset], firstSize);
+		std::memcpy(static_cast<uint8_t*>(dest) + firstSize, &data[0], size - firstSize);
+	}
+
+	uint32_t reserve(uint32_t count)
+	{
+		auto pos = writePos.load(std::memory_order_relaxed);
+		while(true)
+		{
+			// the consumer frees slots in order, so if the last one is free for this lap all of them are
+			auto lastPos = pos + count - 1;
+			auto &lastSeq = seqs[lastPos & mask()];
+			auto seq = lastSeq.load(std::memory_order_acquire);
+			if(seq == lastPos)
+			{
+				if(writePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+					return pos;
+			}
+			else if(int32_t(seq - lastPos) < 0)
+			{
+				// ring is full, wait for the consumer to free the slot
+				waitingWriters.fetch_add(1);
+				if(lastSeq.load() == seq)
+					lastSeq.wait(seq);
+				waitingWriters.fetch_sub(1);
+				pos = writePos.load(std::memory_order_relaxed);
+			}
+			else
+			{
+				// another writer reserved the slot
+				pos = writePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool write(const MsgType &msg, const void *extraData, size_t extraDataSize)
+	{
+		auto recordSize = sizeof(RecordHeader) + MSG_SIZE + extraDataSize;
+		RecordHeader header{uint32_t((recordSize + slotSize - 1) / slotSize)};
+		if(header.slots > slots) [[unlikely]]
+		{
+			// the record could never fit, reserve() would wait forever
+			log.error("message with {} bytes of extra data exceeds ring size:{}", extraDataSize, dataSize());
+			return false;
+		}
+		auto pos = reserve(header.slots);
+		auto offset = dataOffset(pos);
+		std::memcpy(&data[offset], &header, sizeof(header));
+		std::memcpy(&data[offset + sizeof(header)], static_cast<const void*>(&msg), MSG_SIZE);
+		if(extraDataSize)
+			copyIn((offset + sizeof(header) + MSG_SIZE) % dataSize(), extraData, extraDataSize);
+		// publishing the first slot makes the whole record visible to the consumer,
+		// seq_cst orders it before the isNotified exchange against the consumer's fence
+		seqs[pos & mask()].store(pos + 1);
+		if(!isNotified.exchange(true))
+		{
+			if(useEvent.load())
+				event.notify();
+			else
+				isNotified.notify_one();
+		}
+		return true;
+	}
+
+	bool hasMessage() const
+	{
+		auto pos = recordEnd;
+		return seqs[pos & mask()].load(std::memory_order_acquire) == pos + 1;
+	}
+
+	void freeRecord()
+	{
+		if(readPos == recordEnd)
+			return;
+		for(auto pos = readPos; pos != recordEnd; pos++)
+		{
+			seqs[pos & mask()].store(pos + slots, std::memory_order_release);
+		}
+		// order the stores before the load, pairs with the fetch_add then seq load in reserve()
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(waitingWriters.load()) [[unlikely]]
+		{
+			for(auto pos = readPos; pos != recordEnd; pos++)
+			{
+				seqs[pos & mask()].notify_all();
+			}
+		}
+		readPos = recordEnd;
+	}
+
+	bool readNextMessage(MsgType &msg, bool canBlock)
+	{
+		freeRecord();
+		while(!hasMessage())
+		{
+			if(!canBlock)
+				return false;
+			isNotified.store(false);
+			// order the store before hasMessage()'s load, pairs with the seq store then isNotified exchange in write()
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if(!hasMessage())
+				isNotified.wait(false);
+		}
+		auto offset = dataOffset(readPos);
+		RecordHeader header;
+		std::memcpy(&header, &data[offset], sizeof(header));
+		std::memcpy(static_cast<void*>(&msg), &data[offset + sizeof(header)], MSG_SIZE);
+		recordEnd = readPos + header.slots;
+		extraDataOffset = 0;
+		return true;
+	}
+
+	bool readNextMessage(MsgType &msg)
+	{
+		return readNextMessage(msg, !useEvent.load(std::memory_order_relaxed));
+	}
+
+	size_t readExtraData(void *dest, size_t size)
+	{
+		auto recordBytes = size_t(recordEnd - readPos) * slotSize - sizeof(RecordHeader) - MSG_SIZE;
+		assume(extraDataOffset + size <= recordBytes);
+		copyOut((dataOffset(readPos) + sizeof(RecordHeader) + MSG_SIZE + extraDataOffset) % dataSize(), dest, size);
+		extraDataOffset += size;
+		return size;
+	}
+
+	void runHandler()
+	{
+		// clear before reading so any message sent from now on signals again
+		isNotified.store(false);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(!onMessages(Messages{*this}))
+			detach();
+	}
 };
 
 template<class MsgType>
-using MessagePort = PipeMessagePort<MsgType>;
+using MessagePort = RingMessagePort<MsgType>;
 
 template<class MsgType>
-using Messages = PipeMessages<MsgType>;
+using Messages = RingMessages<MsgType>;
 
 }
@@ -293,6 +293,7 @@ using DeviceOrientationChangedDelegate = DelegateFunc<void (ApplicationContext,
 using SystemOrientationChangedDelegate = DelegateFunc<void (ApplicationContext, Rotation oldRotation, Rotation newRotation)>;
 using TextFieldDelegate = DelegateFunc<void (const char *str)>;
 using SensorChangedDelegate = DelegateFunc<void (SensorValues)>;
+using QueuedKeyEventDelegate = DelegateFunc<bool (const Input::KeyEvent &)>;
 
 // Window events & delegates
 
@@ -26,6 +26,11 @@
 #include <memory>
 #endif
 
+namespace IG::Input
+{
+class EvdevInputThread;
+}
+
 namespace IG
 {
 
@@ -56,9 +61,12 @@ public:
 	void setAcceptIPC(bool on, const char *name);
 	const FS::PathString &appPath() const;
 	void setAppPath(FS::PathString);
+	bool setEvdevInputThread(bool on);
+	Input::EvdevInputThread *evdevInputThread() const { return evdevThread.get(); }
 
 protected:
 	FDEventSource evdevSrc;
+	std::unique_ptr<Input::EvdevInputThread> evdevThread;
 	#if CONFIG_PACKAGE_DBUS
 	GDBusConnection *gbus{};
 	unsigned openPathSub{};
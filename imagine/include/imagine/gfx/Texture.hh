@@ -48,7 +48,10 @@ struct TextureWriteFlags
 {
 	uint8_t
 	async:1{},
-	makeMipmaps:1{};
+	makeMipmaps:1{},
+	// release a locked buffer without updating the texture, single buffered
+	// storage that the renderer reads directly may still show its contents
+	discard:1{};
 };
 
 struct TextureBufferFlags
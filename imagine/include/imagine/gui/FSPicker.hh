@@ -16,6 +16,7 @@
 	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/config/defs.hh>
+#include <imagine/base/ApplicationContext.hh>
 #include <imagine/gfx/GfxText.hh>
 #include <imagine/fs/FSDefs.hh>
 #include <imagine/gui/MenuItem.hh>
@@ -48,6 +49,8 @@ public:
 	using FilterFunc = DelegateFunc<bool(const FS::directory_entry &)>;
 	using OnChangePathDelegate = DelegateFunc<void (FSPicker &, const Input::Event &)>;
 	using OnSelectPathDelegate = DelegateFunc<void (FSPicker &, CStringView filePath, std::string_view displayName, const Input::Event &)>;
+	// lists a directory in place of ApplicationContext::forEachInDirectoryUri(), called from the directory list thread
+	using ListDirectoryDelegate = DelegateFunc<void (CStringView path, DirectoryEntryDelegate)>;
 	enum class Mode : uint8_t { FILE, FILE_IN_DIR, DIR };
 
 	struct FileEntry
@@ -74,6 +77,7 @@ public:
 	void onAddedToController(ViewController *, const Input::Event &) override;
 	void setOnChangePath(OnChangePathDelegate);
 	void setOnSelectPath(OnSelectPathDelegate);
+	void setListDirectory(ListDirectoryDelegate);
 	void onLeftNavBtn(const Input::Event &);
 	void onRightNavBtn(const Input::Event &);
 	void setEmptyPath();
@@ -95,6 +99,7 @@ protected:
 	ViewStack controller;
 	OnChangePathDelegate onChangePath_;
 	OnSelectPathDelegate onSelectPath_;
+	ListDirectoryDelegate listDirectory_;
 	std::vector<FileEntry> dir;
 	std::vector<TableUIState> fileUIStates;
 	FS::RootedPath root;
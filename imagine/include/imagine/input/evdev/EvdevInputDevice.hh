@@ -39,6 +39,10 @@ public:
 	std::span<Axis> motionAxes() { return axis; };
 	int fd() const { return fdSrc.fd(); }
 	static void addPollEvent(Device&, LinuxApplication&);
+	void attach(EventLoop, PollEventDelegate);
+	static SteadyClockTimePoint eventTime(const input_event &);
+	static KeyEvent makeKeyEvent(Device&, SteadyClockTimePoint, uint16_t code, int32_t value);
+	static void processInputEvent(Device&, LinuxApplication&, SteadyClockTimePoint, uint16_t type, uint16_t code, int32_t value);
 
 protected:
 	static constexpr unsigned AXIS_SIZE = 24;
@@ -0,0 +1,89 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/baseDefs.hh>
+#include <imagine/base/EventLoop.hh>
+#include <imagine/base/CustomEvent.hh>
+#include <imagine/input/inputDefs.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/container/RingBuffer.hh>
+#ifndef IG_USE_MODULE_STD
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <thread>
+#endif
+
+namespace IG
+{
+class LinuxApplication;
+}
+
+namespace IG::Input
+{
+
+struct QueuedEvdevEvent
+{
+	Device *devPtr{};
+	SteadyClockTimePoint time{};
+	uint16_t type{};
+	uint16_t code{};
+	int32_t value{};
+};
+
+// Reads evdev devices on a dedicated thread so input isn't delayed by work on the main thread.
+// Events keep their kernel timestamps and are queued for the main thread, or while a key event
+// handler is set, for the thread calling dispatchQueuedEvents() with anything it doesn't
+// handle forwarded to the main thread.
+class EvdevInputThread
+{
+public:
+	static constexpr int threadPriority = -4;
+
+	EvdevInputThread(LinuxApplication &);
+	~EvdevInputThread();
+	void stop();
+	void attach(Device &);
+	void setKeyEventHandler(QueuedKeyEventDelegate);
+	void dispatchQueuedEvents();
+	void flushEvents();
+
+private:
+	static constexpr size_t queueSize = 512;
+	using EventQueue = RingBuffer<QueuedEvdevEvent, RingBufferConf{.fixedSize = queueSize}>;
+
+	LinuxApplication &app;
+	EventLoop eventLoop;
+	std::thread thread;
+	CustomEvent exitEvent;
+	CustomEvent mainThreadEvent;
+	EventQueue eventQueue;
+	EventQueue forwardedEventQueue;
+	// serializes the queue readers and keeps devices alive while a reader uses their events
+	std::mutex readerMutex;
+	QueuedKeyEventDelegate keyEventHandler;
+	std::atomic_bool hasKeyEventHandler{};
+	bool isRunning{true};
+
+	void removeDevice(Device &);
+	void queueEvents(Device &, std::span<const input_event>);
+	void dispatchMainThreadEvents(bool flushAll = false);
+	size_t takeEvents(EventQueue &, std::span<QueuedEvdevEvent>);
+};
+
+}
@@ -45,6 +45,13 @@ uint32_t transformRGB565ToBGRX8888(uint16_t p);
 uint32_t transformRGB888ToRGBX8888(RGBTripleArray p);
 uint32_t transformRGB888ToBGRX8888(RGBTripleArray p);
 
+// vectorized versions of the above for a run of pixels
+void transformRGBX8888ToRGB565N(const uint32_t *src, size_t pixels, uint16_t *dest);
+void transformBGRX8888ToRGB565N(const uint32_t *src, size_t pixels, uint16_t *dest);
+void transformRGB565ToRGBX8888N(const uint16_t *src, size_t pixels, uint32_t *dest);
+void transformRGB565ToBGRX8888N(const uint16_t *src, size_t pixels, uint32_t *dest);
+void transformRGBA8888ToBGRA8888N(const uint32_t *src, size_t pixels, uint32_t *dest);
+
 template <class Func>
 concept PixmapTransformFunc =
 		requires (Func &&f, unsigned data){ f(data); } ||
@@ -323,6 +330,30 @@ public:
 		writeTransformed2<Src, Dest>(func, pixmap);
 	}
 
+	// like writeTransformedDirect() but with a function that transforms a run of pixels:
+	// void(const Src *src, size_t pixels, Dest *dest)
+	template <class Src, class Dest>
+	void writeTransformedLines(auto &&lineFunc, auto pixmap) requires(dataIsMutable)
+	{
+		auto srcData = (const Src*)pixmap.data();
+		auto destData = (Dest*)data_;
+		if(w() == pixmap.w() && !isPadded() && !pixmap.isPadded())
+		{
+			lineFunc(srcData, pixmap.w() * pixmap.h(), destData);
+		}
+		else
+		{
+			auto srcPitchPixels = pixmap.pitchPx();
+			auto destPitchPixels = pitchPx();
+			for([[maybe_unused]] auto h : iotaCount(pixmap.h()))
+			{
+				lineFunc(srcData, pixmap.w(), destData);
+				srcData += srcPitchPixels;
+				destData += destPitchPixels;
+			}
+		}
+	}
+
 protected:
 	PixData *data_{};
 	int pitchPx_{};
@@ -390,12 +421,12 @@ protected:
 
 	static void convertRGB565ToRGBX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToRGBX8888, src);
+		dest.template writeTransformedLines<uint16_t, uint32_t>(transformRGB565ToRGBX8888N, src);
 	}
 
 	static void convertRGB565ToBGRX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToBGRX8888, src);
+		dest.template writeTransformedLines<uint16_t, uint32_t>(transformRGB565ToBGRX8888N, src);
 	}
 
 	static void convertRGBX8888ToRGB888(auto dest, auto src)
@@ -420,17 +451,17 @@ protected:
 
 	static void convertRGBX8888ToRGB565(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBX8888ToRGB565, src);
+		dest.template writeTransformedLines<uint32_t, uint16_t>(transformRGBX8888ToRGB565N, src);
 	}
 
 	static void convertRGBA8888ToBGRA8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBA8888ToBGRA8888, src);
+		dest.template writeTransformedLines<uint32_t, uint32_t>(transformRGBA8888ToBGRA8888N, src);
 	}
 
 	static void convertBGRX8888ToRGB565(auto dest, auto src)
 	{
-		dest.writeTransformed(transformBGRX8888ToRGB565, src);
+		dest.template writeTransformedLines<uint32_t, uint16_t>(transformBGRX8888ToRGB565N, src);
 	}
 };
 
@@ -32,6 +32,18 @@ std::span<uint8_t> vAlloc(size_t bytes);
 std::span<uint8_t> vAllocMirrored(size_t bytes);
 void vFree(std::span<uint8_t>);
 
+// Write tracking for page aligned memory, all pages start dirty and a page becomes
+// dirty again on its first write after the flags are collected. Memory must not be
+// written by the kernel (read() into the buffer, etc.) while tracked. Each first write
+// costs a signal and an mprotect() call, which is more than copying a few hundred KB,
+// so this only pays off for large regions where few pages change between collections.
+// Returns false if the memory isn't aligned to the system page size.
+bool vTrackWrites(std::span<uint8_t>);
+void vUntrackWrites(std::span<uint8_t>);
+// Writes one flag per page to pageFlags, which must hold size / pageSize entries,
+// resets the flags, and re-arms tracking, returns the number of dirty pages
+size_t vCollectDirtyPages(std::span<uint8_t>, std::span<uint8_t> pageFlags);
+
 inline uintptr_t truncPageSize(uintptr_t addr)
 {
 	return addr & ~(pageSize - 1);
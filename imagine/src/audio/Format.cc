@@ -16,10 +16,47 @@
 #include <imagine/audio/Format.hh>
 #include <imagine/util/algorithm.h>
 #include <imagine/util/utility.hh>
+#include <imagine/util/ranges.hh>
+#ifndef IG_USE_MODULE_STD
+#include <cstring>
+#include <type_traits>
+#endif
 
 namespace IG::Audio
 {
 
+// Sample conversion kernels process blocks of 8 samples with generic vector types that
+// lower to SSE/AVX or NEON depending on the target, the remaining samples use scalar code
+using Float4 = float __attribute__((vector_size(16)));
+using Int32x4 = int32_t __attribute__((vector_size(16)));
+using Int16x4 = int16_t __attribute__((vector_size(8)));
+constexpr size_t vecBlockSamples = 8;
+
+template<class V, class T>
+static V loadVec(const T *ptr)
+{
+	V v;
+	std::memcpy(&v, ptr, sizeof(V));
+	return v;
+}
+
+template<class V, class T>
+static void storeVec(T *ptr, V v)
+{
+	std::memcpy(ptr, &v, sizeof(V));
+}
+
+static Float4 clampVec(Float4 v, float min, float max)
+{
+	Float4 minV = Float4{} + min, maxV = Float4{} + max;
+	v = v < minV ? minV : v;
+	return v > maxV ? maxV : v;
+}
+
+// same mapping as remap(x, -1.f, 1.f, std::numeric_limits<int16_t>{})
+constexpr float i16Scale = 32767.5f;
+constexpr float i16Offset = -.5f;
+
 static int16_t remapToInt16(float x)
 {
 	assume(x >= -1.f && x <= 1.f);
@@ -31,17 +68,45 @@ static int16_t remapClampToInt16(float x)
 	return remapClamp(x, -1.f, 1.f, std::numeric_limits<int16_t>{});
 }
 
+static Int16x4 remapToInt16(Float4 x, bool clamp)
+{
+	auto v = x * i16Scale + i16Offset;
+	if(clamp)
+		v = clampVec(v, -32768.f, 32767.f);
+	return __builtin_convertvector(__builtin_convertvector(v, Int32x4), Int16x4);
+}
+
+static Float4 toFloat(Int16x4 s)
+{
+	return __builtin_convertvector(s, Float4) / 32768.f;
+}
+
 static float *convertI16SamplesToFloat(float * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
 {
-	return transformN(src, samples, dest, [=](int16_t s){ return (float(s) / 32768.f) * volume; });
+	auto vecSamples = samples - samples % vecBlockSamples;
+	for(size_t i = 0; i < vecSamples; i += vecBlockSamples)
+	{
+		storeVec(dest + i, toFloat(loadVec<Int16x4>(src + i)) * volume);
+		storeVec(dest + i + 4, toFloat(loadVec<Int16x4>(src + i + 4)) * volume);
+	}
+	return transformN(src + vecSamples, samples - vecSamples, dest + vecSamples,
+		[=](int16_t s){ return (float(s) / 32768.f) * volume; });
 }
 
 static int16_t *convertFloatSamplesToI16(int16_t * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
 {
-	if(volume <= 1.f)
-		return transformN(src, samples, dest, [=](float s){ return remapToInt16(s * volume); });
+	// input is assumed to be in [-1, 1] so only volume boost needs clamping
+	const bool clamp = volume > 1.f;
+	auto vecSamples = samples - samples % vecBlockSamples;
+	for(size_t i = 0; i < vecSamples; i += vecBlockSamples)
+	{
+		storeVec(dest + i, remapToInt16(loadVec<Float4>(src + i) * volume, clamp));
+		storeVec(dest + i + 4, remapToInt16(loadVec<Float4>(src + i + 4) * volume, clamp));
+	}
+	if(!clamp)
+		return transformN(src + vecSamples, samples - vecSamples, dest + vecSamples, [=](float s){ return remapToInt16(s * volume); });
 	else
-		return transformN(src, samples, dest, [=](float s){ return remapClampToInt16(s * volume); });
+		return transformN(src + vecSamples, samples - vecSamples, dest + vecSamples, [=](float s){ return remapClampToInt16(s * volume); });
 }
 
 static int16_t *copyI16Samples(int16_t * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
@@ -50,13 +115,17 @@ static int16_t *copyI16Samples(int16_t * __restrict__ dest, size_t samples, cons
 	{
 		return copy_n(src, samples, dest);
 	}
-	else
+	const bool clamp = volume > 1.f;
+	auto vecSamples = samples - samples % vecBlockSamples;
+	for(size_t i = 0; i < vecSamples; i += vecBlockSamples)
 	{
-		if(volume <= 1.f)
-			return transformN(src, samples, dest, [=](int16_t s){ return remapToInt16((float(s) / 32768.f) * volume); });
-		else
-			return transformN(src, samples, dest, [=](int16_t s){ return remapClampToInt16((float(s) / 32768.f) * volume); });
+		storeVec(dest + i, remapToInt16(toFloat(loadVec<Int16x4>(src + i)) * volume, clamp));
+		storeVec(dest + i + 4, remapToInt16(toFloat(loadVec<Int16x4>(src + i + 4)) * volume, clamp));
 	}
+	if(!clamp)
+		return transformN(src + vecSamples, samples - vecSamples, dest + vecSamples, [=](int16_t s){ return remapToInt16((float(s) / 32768.f) * volume); });
+	else
+		return transformN(src + vecSamples, samples - vecSamples, dest + vecSamples, [=](int16_t s){ return remapClampToInt16((float(s) / 32768.f) * volume); });
 }
 
 static float *copyFloatSamples(float * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
@@ -65,15 +134,75 @@ static float *copyFloatSamples(float * __restrict__ dest, size_t samples, const
 	{
 		return copy_n(src, samples, dest);
 	}
+	auto vecSamples = samples - samples % vecBlockSamples;
+	for(size_t i = 0; i < vecSamples; i += vecBlockSamples)
+	{
+		storeVec(dest + i, loadVec<Float4>(src + i) * volume);
+		storeVec(dest + i + 4, loadVec<Float4>(src + i + 4) * volume);
+	}
+	return transformN(src + vecSamples, samples - vecSamples, dest + vecSamples, [=](float s){ return s * volume; });
+}
+
+template<class T>
+static void monoToStereo(T * __restrict__ dest, size_t frames, const T * __restrict__ src)
+{
+	for(auto i : iotaCount(frames))
+	{
+		dest[i * 2] = dest[i * 2 + 1] = src[i];
+	}
+}
+
+template<class T>
+static void stereoToMono(T * __restrict__ dest, size_t frames, const T * __restrict__ src)
+{
+	for(auto i : iotaCount(frames))
+	{
+		if constexpr(std::is_floating_point_v<T>)
+			dest[i] = (src[i * 2] + src[i * 2 + 1]) * .5f;
+		else
+			dest[i] = (int32_t(src[i * 2]) + int32_t(src[i * 2 + 1])) >> 1;
+	}
+}
+
+static void convertChannels(void * __restrict__ dest, int destChannels, const void * __restrict__ src, size_t frames, SampleFormat format)
+{
+	if(destChannels == 2)
+	{
+		if(format.isFloat())
+			monoToStereo(static_cast<float*>(dest), frames, static_cast<const float*>(src));
+		else
+			monoToStereo(static_cast<int16_t*>(dest), frames, static_cast<const int16_t*>(src));
+	}
 	else
 	{
-		return transformN(src, samples, dest, [=](float s){ return s * volume; });
+		if(format.isFloat())
+			stereoToMono(static_cast<float*>(dest), frames, static_cast<const float*>(src));
+		else
+			stereoToMono(static_cast<int16_t*>(dest), frames, static_cast<const int16_t*>(src));
 	}
 }
 
 void *Format::copyFrames(void * __restrict__ dest, const void * __restrict__ src, size_t frames, Format srcFormat, float volume) const
 {
-	assume(channels == srcFormat.channels);
+	assume(channels >= 1 && channels <= 2 && srcFormat.channels >= 1 && srcFormat.channels <= 2);
+	if(channels != srcFormat.channels) [[unlikely]]
+	{
+		// convert the channel layout in blocks on the stack, then the sample format
+		constexpr size_t blockFrames = 256;
+		alignas(16) char block[blockFrames * 2 * sizeof(float)];
+		Format blockFormat{srcFormat.rate, srcFormat.sample, channels};
+		auto destPtr = dest;
+		auto srcPtr = static_cast<const char*>(src);
+		while(frames)
+		{
+			auto framesToCopy = std::min(frames, blockFrames);
+			convertChannels(block, channels, srcPtr, framesToCopy, srcFormat.sample);
+			destPtr = copyFrames(destPtr, block, framesToCopy, blockFormat, volume);
+			srcPtr += srcFormat.framesToBytes(framesToCopy);
+			frames -= framesToCopy;
+		}
+		return destPtr;
+	}
 	auto samples = frames * channels;
 	switch(sample.bytes())
 	{
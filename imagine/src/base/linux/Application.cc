@@ -15,6 +15,7 @@
 
 #include <imagine/config/macros.h>
 #include <imagine/base/Application.hh>
+#include <imagine/input/evdev/EvdevInputThread.hh>
 #include <imagine/logger/SystemLogger.hh>
 
 namespace IG
@@ -15,6 +15,7 @@
 
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/base/Application.hh>
+#include <imagine/input/evdev/EvdevInputThread.hh>
 #include <imagine/fs/FS.hh>
 #include <imagine/util/format.hh>
 #include <imagine/logger/SystemLogger.hh>
@@ -149,4 +150,20 @@ bool ApplicationContext::registerInstance(ApplicationInitParams initParams, cons
 
 void ApplicationContext::setAcceptIPC(bool on, const char *name) { application().setAcceptIPC(on, name); }
 
+bool ApplicationContext::setInputThread(bool on) { return application().setEvdevInputThread(on); }
+
+bool ApplicationContext::hasInputThread() const { return application().evdevInputThread(); }
+
+void ApplicationContext::setQueuedKeyEventHandler(QueuedKeyEventDelegate del)
+{
+	if(auto inputThread = application().evdevInputThread())
+		inputThread->setKeyEventHandler(del);
+}
+
+void ApplicationContext::dispatchQueuedInputEvents()
+{
+	if(auto inputThread = application().evdevInputThread())
+		inputThread->dispatchQueuedEvents();
+}
+
 }
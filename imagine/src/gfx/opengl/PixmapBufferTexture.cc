@@ -235,7 +235,8 @@ template<class Impl, class BufferInfo>
 void GLTextureStorage<Impl, BufferInfo>::unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags)
 {
 	Texture::unlock(lockBuff, writeFlags);
-	swapBuffer();
+	if(!writeFlags.discard)
+		swapBuffer();
 }
 
 template<class Impl, class BufferInfo>
@@ -464,6 +464,12 @@ void Texture::unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags)
 {
 	if(!lockBuff) [[unlikely]]
 		return;
+	if(writeFlags.discard)
+	{
+		if(!lockBuff.pbo() && lockBuff.shouldFreeBuffer())
+			std::free(lockBuff.pixmap().data());
+		return;
+	}
 	if(lockBuff.pbo())
 	{
 		assume(renderer().support.hasPBOFuncs);
@@ -130,10 +130,11 @@ LockedTextureBuffer HardwareBufferStorage<Buffer>::lock(TextureBufferFlags buffe
 }
 
 template<class Buffer>
-void HardwareBufferStorage<Buffer>::unlock(LockedTextureBuffer, TextureWriteFlags)
+void HardwareBufferStorage<Buffer>::unlock(LockedTextureBuffer, TextureWriteFlags writeFlags)
 {
 	bufferInfo[bufferIdx].buffer.unlock();
-	swapBuffer();
+	if(!writeFlags.discard)
+		swapBuffer();
 }
 
 template<class Buffer>
@@ -171,14 +171,18 @@ LockedTextureBuffer SurfaceTextureStorage::lock(TextureBufferFlags bufferFlags)
 	return lockedBuffer(winBuffer.bits, (uint32_t)winBuffer.stride * bpp, bufferFlags);
 }
 
-void SurfaceTextureStorage::unlock(LockedTextureBuffer, TextureWriteFlags)
+void SurfaceTextureStorage::unlock(LockedTextureBuffer, TextureWriteFlags writeFlags)
 {
 	if(!nativeWin) [[unlikely]]
 	{
 		log.error("called unlock when uninitialized");
 		return;
 	}
+	// a window buffer can't be unlocked without posting it, but when double buffered a discarded
+	// one isn't latched into the texture so the next posted buffer replaces it
 	ANativeWindow_unlockAndPost(nativeWin);
+	if(writeFlags.discard && !singleBuffered)
+		return;
 	task().run(
 		[tex = surfaceTex, app = task().appContext()]()
 		{
@@ -111,6 +111,11 @@ void FSPicker::setOnChangePath(OnChangePathDelegate del)
 	onChangePath_ = del;
 }
 
+void FSPicker::setListDirectory(ListDirectoryDelegate del)
+{
+	listDirectory_ = del;
+}
+
 void FSPicker::setOnSelectPath(OnSelectPathDelegate del)
 {
 	onSelectPath_ = del;
@@ -486,7 +491,7 @@ void FSPicker::listDirectory(CStringView path, ThreadStop &stop)
 {
 	try
 	{
-		appContext().forEachInDirectoryUri(path,
+		DirectoryEntryDelegate onEntry =
 			[this, &stop](auto &entry)
 			{
 				//log.info("entry:{}", entry.path());
@@ -515,7 +520,11 @@ void FSPicker::listDirectory(CStringView path, ThreadStop &stop)
 				if(mode_ == Mode::DIR && !isDir)
 					item.text.setActive(false);
 				return true;
-			});
+			};
+		if(listDirectory_)
+			listDirectory_(path, onEntry);
+		else
+			appContext().forEachInDirectoryUri(path, onEntry);
 		std::ranges::sort(dir,
 			[](const FileEntry &e1, const FileEntry &e2)
 			{
@@ -367,6 +367,14 @@ void ApplicationContext::flushInternalInputEvents()
 
 [[gnu::weak]] void ApplicationContext::flushSystemInputEvents() {}
 
+[[gnu::weak]] bool ApplicationContext::setInputThread(bool) { return false; }
+
+[[gnu::weak]] bool ApplicationContext::hasInputThread() const { return false; }
+
+[[gnu::weak]] void ApplicationContext::setQueuedKeyEventHandler(QueuedKeyEventDelegate) {}
+
+[[gnu::weak]] void ApplicationContext::dispatchQueuedInputEvents() {}
+
 bool BaseApplication::processICadeKey(const Input::KeyEvent &e, Window &win)
 {
 	using namespace IG::Input;
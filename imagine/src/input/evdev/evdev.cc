@@ -14,6 +14,8 @@
 	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/base/Application.hh>
+#include <imagine/input/evdev/EvdevInputThread.hh>
+#include <imagine/thread/Thread.hh>
 #include <imagine/fs/FS.hh>
 #include <imagine/util/format.hh>
 #include <imagine/logger/SystemLogger.hh>
@@ -23,6 +25,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <time.h>
 
 #define DEV_NODE_PATH "/dev/input"
 
@@ -112,41 +115,53 @@ EvdevInputDevice::EvdevInputDevice(int id, UniqueFileDescriptor fd, DeviceTypeFl
 		typeFlags_.joystick = true;
 }
 
-void EvdevInputDevice::processInputEvents(Device &dev, LinuxApplication &app, std::span<const input_event> events)
+KeyEvent EvdevInputDevice::makeKeyEvent(Device &dev, SteadyClockTimePoint time, uint16_t code, int32_t value)
 {
-	for(auto &ev : events)
+	return {Map::SYSTEM, toSysKey(code), value ? Action::PUSHED : Action::RELEASED, 0, 0, Source::GAMEPAD, time, &dev};
+}
+
+void EvdevInputDevice::processInputEvent(Device &dev, LinuxApplication &app, SteadyClockTimePoint time, uint16_t type, uint16_t code, int32_t value)
+{
+	switch(type)
 	{
-		//log.debug("got event type {}, code {}, value {}", ev.type, ev.code, ev.value);
-		auto time = SteadyClockTimePoint{Seconds{ev.time.tv_sec} + Microseconds{ev.time.tv_usec}};
-		switch(ev.type)
+		case EV_KEY:
 		{
-			case EV_KEY:
-			{
-				//log.debug("got key event code:{:X} value:{}", ev.code, ev.value);
-				auto key = toSysKey(ev.code);
-				KeyEvent event{Map::SYSTEM, key, ev.value ? Action::PUSHED : Action::RELEASED, 0, 0, Source::GAMEPAD, time, &dev};
-				app.dispatchRepeatableKeyInputEvent(event);
-				break;
-			}
-			case EV_ABS:
+			//log.debug("got key event code:{:X} value:{}", code, value);
+			app.dispatchRepeatableKeyInputEvent(makeKeyEvent(dev, time, code, value));
+			break;
+		}
+		case EV_ABS:
+		{
+			auto &evDev = getAs<EvdevInputDevice>(dev);
+			auto &axis = evDev.axis;
+			auto axisIt = std::ranges::find_if(axis, [&](auto &axis){ return code == (uint8_t)axis.id(); });
+			if(axisIt == axis.end())
 			{
-				auto &evDev = getAs<EvdevInputDevice>(dev);
-				auto &axis = evDev.axis;
-				auto axisIt = std::ranges::find_if(axis, [&](auto &axis){ return ev.code == (uint8_t)axis.id(); });
-				if(axisIt == axis.end())
-				{
-					log.debug("event from unused axis:{}", ev.code);
-					continue;
-				}
-				auto offset = evDev.axisRangeOffset[std::distance(axis.begin(), axisIt)];
-				float val = (ev.value + offset) * axisIt->scale();
-				//log.debug("got abs event code {:X}, value {} ({})", ev.code, ev.value, val);
-				axisIt->dispatchInputEvent(val, Map::SYSTEM, time, dev, app.mainWindow());
+				log.debug("event from unused axis:{}", code);
+				return;
 			}
+			auto offset = evDev.axisRangeOffset[std::distance(axis.begin(), axisIt)];
+			float val = (value + offset) * axisIt->scale();
+			//log.debug("got abs event code {:X}, value {} ({})", code, value, val);
+			axisIt->dispatchInputEvent(val, Map::SYSTEM, time, dev, app.mainWindow());
 		}
 	}
 }
 
+SteadyClockTimePoint EvdevInputDevice::eventTime(const input_event &ev)
+{
+	return SteadyClockTimePoint{Seconds{ev.time.tv_sec} + Microseconds{ev.time.tv_usec}};
+}
+
+void EvdevInputDevice::processInputEvents(Device &dev, LinuxApplication &app, std::span<const input_event> events)
+{
+	for(auto &ev : events)
+	{
+		//log.debug("got event type {}, code {}, value {}", ev.type, ev.code, ev.value);
+		processInputEvent(dev, app, eventTime(ev), ev.type, ev.code, ev.value);
+	}
+}
+
 bool EvdevInputDevice::setupJoystickBits()
 {
 	ulong evBit[IG::divRoundUp(EV_MAX, IG::bitSize<ulong>)]{};
@@ -200,7 +215,7 @@ void EvdevInputDevice::addPollEvent(Device &dev, LinuxApplication &app)
 {
 	auto &evDev = getAs<EvdevInputDevice>(dev);
 	assume(evDev.fd() >= 0);
-	evDev.fdSrc.setCallback([&dev, &app](int fd, int pollEvents)
+	evDev.attach(EventLoop::forThread(), [&dev, &app](int fd, int pollEvents)
 	{
 		if(pollEvents & pollEventError) [[unlikely]]
 		{
@@ -229,6 +244,186 @@ void EvdevInputDevice::addPollEvent(Device &dev, LinuxApplication &app)
 	});
 }
 
+void EvdevInputDevice::attach(EventLoop loop, PollEventDelegate del)
+{
+	fdSrc.setCallback(del);
+	fdSrc.attach(loop);
+}
+
+static bool isEvdevInputDevice(Input::Device &d)
+{
+	return d.map() == Input::Map::SYSTEM && d.typeFlags().gamepad;
+}
+
+EvdevInputThread::EvdevInputThread(LinuxApplication &app):
+	app{app},
+	exitEvent{{.debugLabel = "EvdevInputThread Exit"}, [this]{ isRunning = false; }},
+	mainThreadEvent{{.debugLabel = "EvdevInputThread Events", .eventLoop = EventLoop::forThread()},
+		[this]{ dispatchMainThreadEvents(); }}
+{
+	thread = makeThreadSync([this](auto &sem)
+	{
+		eventLoop = EventLoop::makeForThread();
+		exitEvent.attach(eventLoop);
+		setThisThreadPriority(threadPriority);
+		sem.release();
+		log.info("starting input thread:{}", thisThreadId());
+		eventLoop.run(isRunning);
+		log.info("exiting input thread:{}", thisThreadId());
+		exitEvent.detach();
+	});
+	for(auto &devPtr : app.inputDevices())
+	{
+		if(isEvdevInputDevice(*devPtr))
+			attach(*devPtr);
+	}
+}
+
+EvdevInputThread::~EvdevInputThread()
+{
+	stop();
+}
+
+void EvdevInputThread::stop()
+{
+	if(!thread.joinable())
+		return;
+	exitEvent.notify();
+	thread.join();
+	// devices go back to being read on the main thread
+	for(auto &devPtr : app.inputDevices())
+	{
+		if(isEvdevInputDevice(*devPtr))
+			EvdevInputDevice::addPollEvent(*devPtr, app);
+	}
+}
+
+void EvdevInputThread::attach(Device &dev)
+{
+	getAs<EvdevInputDevice>(dev).attach(eventLoop, [this, &dev](int fd, int pollEvents)
+	{
+		if(pollEvents & pollEventError) [[unlikely]]
+		{
+			log.error("error:{} in input fd:{} ({})", errno, fd, dev.name());
+			removeDevice(dev);
+			return false;
+		}
+		input_event event[64];
+		int len;
+		while((len = read(fd, event, sizeof event)) > 0)
+		{
+			queueEvents(dev, {event, len / sizeof(input_event)});
+		}
+		if(len == -1 && errno != EAGAIN)
+		{
+			log.info("error:{} reading from input fd:{} ({})", errno, fd, dev.name());
+			removeDevice(dev);
+			return false;
+		}
+		return true;
+	});
+}
+
+void EvdevInputThread::removeDevice(Device &dev)
+{
+	ApplicationContext{static_cast<Application&>(app)}.runOnMainThread([&app = app, &dev](ApplicationContext ctx)
+	{
+		// dispatch the device's remaining events before it's destroyed
+		if(auto inputThread = app.evdevInputThread())
+			inputThread->flushEvents();
+		app.removeInputDevice(ctx, dev, true);
+	});
+}
+
+void EvdevInputThread::queueEvents(Device &dev, std::span<const input_event> events)
+{
+	bool queued{};
+	for(auto &ev : events)
+	{
+		if(ev.type != EV_KEY && ev.type != EV_ABS)
+			continue;
+		if(!eventQueue.push({&dev, EvdevInputDevice::eventTime(ev), ev.type, ev.code, ev.value})) [[unlikely]]
+		{
+			log.warn("event queue full, dropped event type:{} code:{}", ev.type, ev.code);
+			continue;
+		}
+		queued = true;
+	}
+	if(queued && !hasKeyEventHandler.load(std::memory_order_acquire))
+		mainThreadEvent.notify();
+}
+
+void EvdevInputThread::setKeyEventHandler(QueuedKeyEventDelegate del)
+{
+	keyEventHandler = del;
+	hasKeyEventHandler.store(bool(del), std::memory_order_release);
+	if(!del) // main thread handles any events still in the queue
+		mainThreadEvent.notify();
+}
+
+void EvdevInputThread::dispatchQueuedEvents()
+{
+	// cores may call this every scanline so skip the lock when nothing is queued
+	if(!keyEventHandler || eventQueue.empty())
+		return;
+	bool forwarded{};
+	{
+		std::scoped_lock lock{readerMutex};
+		while(!forwardedEventQueue.full())
+		{
+			auto e = eventQueue.tryPop();
+			if(!e)
+				break;
+			if(e->type == EV_KEY)
+			{
+				auto keyEv = EvdevInputDevice::makeKeyEvent(*e->devPtr, e->time, e->code, e->value);
+				keyEv.setKeyFlags(app.swappedConfirmKeys());
+				if(keyEventHandler(keyEv))
+					continue;
+			}
+			forwardedEventQueue.push(*e);
+			forwarded = true;
+		}
+	}
+	if(forwarded)
+		mainThreadEvent.notify();
+}
+
+size_t EvdevInputThread::takeEvents(EventQueue &queue, std::span<QueuedEvdevEvent> events)
+{
+	size_t count{};
+	while(count < events.size())
+	{
+		auto e = queue.tryPop();
+		if(!e)
+			break;
+		events[count++] = *e;
+	}
+	return count;
+}
+
+void EvdevInputThread::dispatchMainThreadEvents(bool flushAll)
+{
+	std::array<QueuedEvdevEvent, queueSize * 2> events;
+	size_t count{};
+	{
+		std::scoped_lock lock{readerMutex};
+		count = takeEvents(forwardedEventQueue, events);
+		if(flushAll || !hasKeyEventHandler.load(std::memory_order_acquire))
+			count += takeEvents(eventQueue, std::span{events}.subspan(count));
+	}
+	// events are dispatched outside the lock since handlers may wait on the emulation thread
+	for(const auto &e : std::span{events.data(), count})
+	{
+		EvdevInputDevice::processInputEvent(*e.devPtr, app, e.time, e.type, e.code, e.value);
+	}
+}
+
+void EvdevInputThread::flushEvents()
+{
+	dispatchMainThreadEvents(true);
+}
+
 static bool devIsGamepad(int fd)
 {
 	ulong keyBit[IG::divRoundUp(KEY_MAX, IG::bitSize<ulong>)] {0};
@@ -248,11 +443,6 @@ static bool devIsGamepad(int fd)
 	return false;
 }
 
-static bool isEvdevInputDevice(Input::Device &d)
-{
-	return d.map() == Input::Map::SYSTEM && d.typeFlags().gamepad;
-}
-
 static bool processDevNode(LinuxApplication &app, CStringView path, int id, bool notify)
 {
 	if(access(path, R_OK) != 0)
@@ -284,6 +474,12 @@ static bool processDevNode(LinuxApplication &app, CStringView path, int id, bool
 		close(fd);
 		return false;
 	}
+	// report event times from the same clock as SteadyClock so they can be compared with the frame timing
+	int clockId = CLOCK_MONOTONIC;
+	if(ioctl(fd, EVIOCSCLOCKID, &clockId) < 0)
+	{
+		log.warn("unable to set monotonic event clock");
+	}
 	std::array<char, 80> nameStr{"Unknown"};
 	if(ioctl(fd, EVIOCGNAME(sizeof(nameStr)), nameStr.data()) < 0)
 	{
@@ -297,8 +493,12 @@ static bool processDevNode(LinuxApplication &app, CStringView path, int id, bool
 	auto vendorProductId = ((devInfo.vendor & 0xFFFF) << 16) | (devInfo.product & 0xFFFF);
 	auto evDev = std::make_unique<Device>(std::in_place_type<EvdevInputDevice>, id, fd, DeviceTypeFlags{.gamepad = true}, nameStr.data(), vendorProductId);
 	fd_setNonblock(fd, 1);
-	EvdevInputDevice::addPollEvent(*evDev, app);
+	auto &dev = *evDev;
+	EvdevInputDevice::addPollEvent(dev, app);
 	app.addInputDevice(ApplicationContext{static_cast<Application&>(app)}, std::move(evDev), notify);
+	// only move to the input thread once the device is fully added since its events can be handled off the main thread
+	if(auto inputThread = app.evdevInputThread())
+		inputThread->attach(dev);
 	return true;
 }
 
@@ -320,6 +520,23 @@ namespace IG
 
 static SystemLogger log{"Evdev"};
 
+bool LinuxApplication::setEvdevInputThread(bool on)
+{
+	if(on == bool(evdevThread))
+		return true;
+	if(on)
+	{
+		evdevThread = std::make_unique<Input::EvdevInputThread>(*this);
+	}
+	else
+	{
+		evdevThread->stop();
+		evdevThread->flushEvents();
+		evdevThread.reset();
+	}
+	return true;
+}
+
 void LinuxApplication::initEvdev(EventLoop loop)
 {
 	log.info("setting up inotify for hotplug");
@@ -14,6 +14,13 @@
 	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/pixmap/MemPixmap.hh>
+#include "lineKernels.hh"
+
+// x86 builds below the AVX2 baseline get an extra copy of each line kernel
+// compiled for AVX2 that's selected at runtime
+#if (defined __x86_64__ || defined __i386__) && !defined __AVX2__
+#define IG_PIXMAP_AVX2_DISPATCH
+#endif
 
 namespace IG
 {
@@ -108,4 +115,20 @@ static uint32_t transformRGB888ToRGBX8888Impl(RGBTripleArray p)
 uint32_t transformRGB888ToRGBX8888(RGBTripleArray p) { return transformRGB888ToRGBX8888Impl(p); }
 uint32_t transformRGB888ToBGRX8888(RGBTripleArray p) { return transformRGB888ToRGBX8888Impl<true>(p); }
 
+template<class Kernel, class Src, class Dest>
+static void runKernel(const Src *src, size_t pixels, Dest *dest)
+{
+	#ifdef IG_PIXMAP_AVX2_DISPATCH
+	if(hasAVX2())
+		return runKernelAVX2<Kernel>(src, pixels, dest);
+	#endif
+	Kernel::template run<vecBlockPixels>(src, pixels, dest);
+}
+
+void transformRGBX8888ToRGB565N(const uint32_t *src, size_t pixels, uint16_t *dest) { runKernel<RGBX8888ToRGB565Kernel<false>>(src, pixels, dest); }
+void transformBGRX8888ToRGB565N(const uint32_t *src, size_t pixels, uint16_t *dest) { runKernel<RGBX8888ToRGB565Kernel<true>>(src, pixels, dest); }
+void transformRGB565ToRGBX8888N(const uint16_t *src, size_t pixels, uint32_t *dest) { runKernel<RGB565ToRGBX8888Kernel<false>>(src, pixels, dest); }
+void transformRGB565ToBGRX8888N(const uint16_t *src, size_t pixels, uint32_t *dest) { runKernel<RGB565ToRGBX8888Kernel<true>>(src, pixels, dest); }
+void transformRGBA8888ToBGRA8888N(const uint32_t *src, size_t pixels, uint32_t *dest) { runKernel<RGBA8888ToBGRA8888Kernel>(src, pixels, dest); }
+
 }
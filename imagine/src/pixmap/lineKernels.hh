@@ -0,0 +1,159 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+// Line conversion kernels behind the transform*N() functions, shared with the pixmap benchmark
+
+#include <imagine/pixmap/Pixmap.hh>
+#ifndef IG_USE_MODULE_STD
+#include <cstring>
+#include <utility>
+#endif
+
+namespace IG
+{
+
+// Line conversion kernels process blocks of pixels with generic vector types that lower to
+// SSE/AVX or NEON depending on the target, the remaining pixels use the scalar transforms.
+// The divisions by 31, 63, & 255 use multiply-shift pairs that are exact over each formula's input range.
+template<size_t N> struct PixelVec;
+template<> struct PixelVec<8>
+{
+	using U32 = uint32_t __attribute__((vector_size(32)));
+	using U16 = uint16_t __attribute__((vector_size(16)));
+};
+template<> struct PixelVec<16>
+{
+	using U32 = uint32_t __attribute__((vector_size(64)));
+	using U16 = uint16_t __attribute__((vector_size(32)));
+};
+template<size_t N> using U32Vec = PixelVec<N>::U32;
+template<size_t N> using U16Vec = PixelVec<N>::U16;
+#ifdef __AVX2__
+constexpr size_t vecBlockPixels = 16;
+#else
+constexpr size_t vecBlockPixels = 8;
+#endif
+
+// vectors are only passed by reference so no function's ABI depends on the enabled vector extensions
+template<class V, class T>
+[[gnu::always_inline]] inline void loadVec(V &v, const T *ptr)
+{
+	std::memcpy(&v, ptr, sizeof(V));
+}
+
+template<class V, class T>
+[[gnu::always_inline]] inline void storeVec(T *ptr, const V &v)
+{
+	std::memcpy(ptr, &v, sizeof(V));
+}
+
+template<class V>
+[[gnu::always_inline]] inline void divide(V &n, unsigned mul, unsigned shift)
+{
+	n = n * mul >> shift;
+}
+
+// n / 255 for n <= 16192, n / 63 for n <= 16096, n / 31 for n <= 7920
+[[gnu::always_inline]] inline void div255(auto &n) { divide(n, 16449, 22); }
+[[gnu::always_inline]] inline void div63(auto &n) { divide(n, 16645, 20); }
+[[gnu::always_inline]] inline void div31(auto &n) { divide(n, 8457, 18); }
+
+template <bool BGR_SWAP>
+struct RGBX8888ToRGB565Kernel
+{
+	template<size_t N>
+	[[gnu::always_inline]] static inline void run(const uint32_t *src, size_t pixels, uint16_t *dest)
+	{
+		auto vecPixels = pixels - pixels % N;
+		for(size_t i = 0; i < vecPixels; i += N)
+		{
+			U32Vec<N> p;
+			loadVec(p, src + i);
+			auto r = p & 0xFF;
+			auto g = p >> 8 & 0xFF;
+			auto b = p >> 16 & 0xFF;
+			if constexpr(BGR_SWAP) { std::swap(r, b); }
+			// (r * 62 + 255) / 510 reduces to the same rounding as the blue channel
+			r = r * 31 + 127; div255(r);
+			g = g * 63 + 127; div255(g);
+			b = b * 31 + 127; div255(b);
+			storeVec(dest + i, __builtin_convertvector(r << 11 | g << 5 | b, U16Vec<N>));
+		}
+		transformN(src + vecPixels, pixels - vecPixels, dest + vecPixels, BGR_SWAP ? transformBGRX8888ToRGB565 : transformRGBX8888ToRGB565);
+	}
+};
+
+template <bool BGR_SWAP>
+struct RGB565ToRGBX8888Kernel
+{
+	template<size_t N>
+	[[gnu::always_inline]] static inline void run(const uint16_t *src, size_t pixels, uint32_t *dest)
+	{
+		auto vecPixels = pixels - pixels % N;
+		for(size_t i = 0; i < vecPixels; i += N)
+		{
+			U16Vec<N> p16;
+			loadVec(p16, src + i);
+			auto p = __builtin_convertvector(p16, U32Vec<N>);
+			auto b = p & 0x1F;
+			auto g = p >> 5 & 0x3F;
+			auto r = p >> 11 & 0x1F;
+			if constexpr(BGR_SWAP) { std::swap(r, b); }
+			b = b * 255 + 15; div31(b);
+			g = g * 255 + 31; div63(g);
+			r = r * 255 + 15; div31(r);
+			storeVec(dest + i, b << 16 | g << 8 | r);
+		}
+		transformN(src + vecPixels, pixels - vecPixels, dest + vecPixels, BGR_SWAP ? transformRGB565ToBGRX8888 : transformRGB565ToRGBX8888);
+	}
+};
+
+struct RGBA8888ToBGRA8888Kernel
+{
+	template<size_t N>
+	[[gnu::always_inline]] static inline void run(const uint32_t *src, size_t pixels, uint32_t *dest)
+	{
+		auto vecPixels = pixels - pixels % N;
+		for(size_t i = 0; i < vecPixels; i += N)
+		{
+			U32Vec<N> p;
+			loadVec(p, src + i);
+			storeVec(dest + i, (p & 0xFF00FF00) | (p >> 16 & 0xFF) | (p & 0xFF) << 16);
+		}
+		transformN(src + vecPixels, pixels - vecPixels, dest + vecPixels, transformRGBA8888ToBGRA8888);
+	}
+};
+
+#if defined __x86_64__ || defined __i386__
+template<class Kernel, class Src, class Dest>
+[[gnu::target("avx2")]] inline void runKernelAVX2(const Src *src, size_t pixels, Dest *dest)
+{
+	Kernel::template run<16>(src, pixels, dest);
+}
+
+inline bool hasAVX2()
+{
+	static const bool hasAVX2 = []()
+	{
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+	}();
+	return hasAVX2;
+}
+#endif
+
+}
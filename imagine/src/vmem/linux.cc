@@ -15,9 +15,15 @@
 
 #include <imagine/vmem/memory.hh>
 #include <imagine/util/utility.hh>
+#include <imagine/util/ranges.hh>
 #include <imagine/logger/SystemLogger.hh>
 #include <sys/mman.h>
 #include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <algorithm>
 #if defined __ANDROID__ && ANDROID_MIN_API <= 24
 #define NEEDS_MREMAP_SYSCALL
 #include <unistd.h>
@@ -85,4 +91,131 @@ std::span<uint8_t> vAllocMirrored(size_t bytes)
 	return buff;
 }
 
+struct WriteTrackedRegion
+{
+	uint8_t *start{};
+	uint8_t *end{};
+	std::unique_ptr<uint8_t[]> dirtyPages;
+
+	bool contains(const uint8_t *p) const { return p >= start && p < end; }
+};
+
+static constexpr int maxWriteTrackedRegions = 8;
+static WriteTrackedRegion writeTrackedRegions[maxWriteTrackedRegions];
+static struct sigaction prevSegvAction{};
+static bool segvHandlerInstalled{};
+
+static void onWriteFault(int sig, siginfo_t *info, void *ctx)
+{
+	auto addr = static_cast<uint8_t*>(info->si_addr);
+	for(auto &r : writeTrackedRegions)
+	{
+		if(!r.contains(addr))
+			continue;
+		auto page = uintptr_t(addr - r.start) / pageSize;
+		r.dirtyPages[page] = 1;
+		mprotect(r.start + page * pageSize, pageSize, PROT_READ | PROT_WRITE);
+		return;
+	}
+	// not a tracked write, pass to the previous handler
+	if(prevSegvAction.sa_flags & SA_SIGINFO)
+	{
+		prevSegvAction.sa_sigaction(sig, info, ctx);
+	}
+	else if(prevSegvAction.sa_handler == SIG_DFL || prevSegvAction.sa_handler == SIG_IGN)
+	{
+		// restore the default action and let the faulting instruction run again
+		sigaction(sig, &prevSegvAction, nullptr);
+	}
+	else
+	{
+		prevSegvAction.sa_handler(sig);
+	}
+}
+
+static WriteTrackedRegion *findWriteTrackedRegion(std::span<uint8_t> buff)
+{
+	for(auto &r : writeTrackedRegions)
+	{
+		if(r.start == buff.data())
+			return &r;
+	}
+	return {};
+}
+
+bool vTrackWrites(std::span<uint8_t> buff)
+{
+	// memory aligned for a smaller page size than the kernel's (4K vs 16K/64K) can't be protected per page
+	if(buff.data() != truncPageSize(buff.data()) || !buff.size() || buff.size() != roundPageSize(buff.size())) [[unlikely]]
+	{
+		log.info("can't track writes to {} bytes at:{} with page size:{}", buff.size(), (void*)buff.data(), pageSize);
+		return false;
+	}
+	if(findWriteTrackedRegion(buff))
+		return true;
+	auto regionPtr = findWriteTrackedRegion({});
+	if(!regionPtr) [[unlikely]]
+	{
+		log.error("no free write tracking regions");
+		return false;
+	}
+	if(!segvHandlerInstalled)
+	{
+		struct sigaction action{};
+		action.sa_sigaction = onWriteFault;
+		action.sa_flags = SA_SIGINFO | SA_RESTART;
+		sigemptyset(&action.sa_mask);
+		if(sigaction(SIGSEGV, &action, &prevSegvAction) == -1) [[unlikely]]
+		{
+			log.error("error installing SIGSEGV handler");
+			return false;
+		}
+		segvHandlerInstalled = true;
+	}
+	auto &region = *regionPtr;
+	auto pages = buff.size() / pageSize;
+	// pages are write protected once their dirty flag is first collected
+	region.dirtyPages = std::make_unique<uint8_t[]>(pages);
+	std::fill_n(region.dirtyPages.get(), pages, 1);
+	region.end = buff.data() + buff.size();
+	region.start = buff.data();
+	log.info("tracking writes to {} pages at:{}", pages, (void*)buff.data());
+	return true;
+}
+
+void vUntrackWrites(std::span<uint8_t> buff)
+{
+	auto regionPtr = findWriteTrackedRegion(buff);
+	if(!regionPtr)
+		return;
+	mprotect(buff.data(), buff.size(), PROT_READ | PROT_WRITE);
+	*regionPtr = {};
+}
+
+size_t vCollectDirtyPages(std::span<uint8_t> buff, std::span<uint8_t> pageFlags)
+{
+	auto regionPtr = findWriteTrackedRegion(buff);
+	auto pages = buff.size() / pageSize;
+	assume(pageFlags.size() >= pages);
+	if(!regionPtr) [[unlikely]]
+	{
+		std::fill_n(pageFlags.data(), pages, 1);
+		return pages;
+	}
+	size_t dirtyPages{};
+	for(auto i : iotaCount(pages))
+	{
+		pageFlags[i] = std::exchange(regionPtr->dirtyPages[i], 0);
+		dirtyPages += pageFlags[i];
+	}
+	// re-arm the whole region with one call instead of one per dirty page
+	if(dirtyPages && mprotect(buff.data(), buff.size(), PROT_READ) == -1) [[unlikely]]
+	{
+		log.error("error in mprotect:{}", std::strerror(errno));
+		// writes can't be detected, keep reporting as dirty
+		std::fill_n(regionPtr->dirtyPages.get(), pages, 1);
+	}
+	return dirtyPages;
+}
+
 }
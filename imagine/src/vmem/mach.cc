@@ -17,6 +17,7 @@
 #include <imagine/util/utility.hh>
 #include <imagine/logger/SystemLogger.hh>
 #include <mach/mach.h>
+#include <algorithm>
 #include <mach/vm_map.h>
 #include <mach/machine/vm_param.h>
 
@@ -79,4 +80,15 @@ std::span<uint8_t> vAllocMirrored(size_t bytes)
 	return buff;
 }
 
+// Write tracking isn't implemented, callers treat all pages as dirty
+bool vTrackWrites(std::span<uint8_t>) { return false; }
+void vUntrackWrites(std::span<uint8_t>) {}
+
+size_t vCollectDirtyPages(std::span<uint8_t> buff, std::span<uint8_t> pageFlags)
+{
+	auto pages = buff.size() / pageSize;
+	std::fill_n(pageFlags.data(), pages, 1);
+	return pages;
+}
+
 }
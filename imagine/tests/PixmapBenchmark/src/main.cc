@@ -0,0 +1,111 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+// Times each implementation of the transform*N() line conversions on a frame sized buffer:
+// pixmapBenchmark [width] [height] [iterations]
+
+#include "lineKernels.hh"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+namespace pixmapBenchmark
+{
+
+using namespace IG;
+
+struct Result
+{
+	double bestMs{};
+	bool matches{};
+};
+
+template<class Src, class Dest>
+static Result timeConversion(auto &&convert, const std::vector<Src> &src, const std::vector<Dest> &expected, int iterations)
+{
+	std::vector<Dest> dest(src.size());
+	double bestMs = 1e9;
+	for(int i = 0; i < iterations; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		convert(src.data(), src.size(), dest.data());
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		bestMs = std::min(bestMs, elapsed.count());
+	}
+	return {bestMs, expected.empty() || dest == expected};
+}
+
+static void printResult(std::string_view name, Result res, double scalarMs)
+{
+	std::printf("  %-14.*s %8.3fms %6.2fx%s\n", int(name.size()), name.data(), res.bestMs, scalarMs / res.bestMs,
+		res.matches ? "" : " (output differs from scalar)");
+}
+
+template<class Kernel, class Src, class Dest>
+static void benchmark(std::string_view name, Dest(*scalarFunc)(Src), void(*dispatchedFunc)(const Src*, size_t, Dest*),
+	size_t pixels, int iterations)
+{
+	std::vector<Src> src(pixels);
+	for(size_t i = 0; i < pixels; i++)
+		src[i] = Src(i * 2654435761u); // spread values over all channels
+	std::printf("%.*s:\n", int(name.size()), name.data());
+	// the scalar transforms are out of line so this matches the per-pixel conversion the kernels replaced
+	auto scalarConvert = [&](const Src *s, size_t n, Dest *d){ transformN(s, n, d, scalarFunc); };
+	auto scalar = timeConversion(scalarConvert, src, std::vector<Dest>{}, iterations);
+	std::vector<Dest> expected(pixels);
+	scalarConvert(src.data(), pixels, expected.data());
+	printResult("scalar", scalar, scalar.bestMs);
+	#if defined __x86_64__ || defined __i386__
+	printResult(vecBlockPixels == 16 ? "8px (AVX2)" : "8px (SSE2)",
+		timeConversion(Kernel::template run<8>, src, expected, iterations), scalar.bestMs);
+	if(hasAVX2())
+		printResult("16px (AVX2)", timeConversion(runKernelAVX2<Kernel, Src, Dest>, src, expected, iterations), scalar.bestMs);
+	#else
+	printResult("8px (NEON)", timeConversion(Kernel::template run<8>, src, expected, iterations), scalar.bestMs);
+	#endif
+	printResult("dispatched", timeConversion(dispatchedFunc, src, expected, iterations), scalar.bestMs);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace IG;
+	using namespace pixmapBenchmark;
+	size_t width = argc > 1 ? std::atoi(argv[1]) : 3840;
+	size_t height = argc > 2 ? std::atoi(argv[2]) : 2160;
+	int iterations = argc > 3 ? std::atoi(argv[3]) : 20;
+	auto pixels = width * height;
+	if(!pixels || iterations < 1)
+	{
+		std::fprintf(stderr, "usage: %s [width] [height] [iterations]\n", argv[0]);
+		return 1;
+	}
+	std::printf("%zux%zu, best of %d\n", width, height, iterations);
+	benchmark<RGBX8888ToRGB565Kernel<false>>("RGBX8888 -> RGB565",
+		transformRGBX8888ToRGB565, transformRGBX8888ToRGB565N, pixels, iterations);
+	benchmark<RGBX8888ToRGB565Kernel<true>>("BGRX8888 -> RGB565",
+		transformBGRX8888ToRGB565, transformBGRX8888ToRGB565N, pixels, iterations);
+	benchmark<RGB565ToRGBX8888Kernel<false>>("RGB565 -> RGBX8888",
+		transformRGB565ToRGBX8888, transformRGB565ToRGBX8888N, pixels, iterations);
+	benchmark<RGB565ToRGBX8888Kernel<true>>("RGB565 -> BGRX8888",
+		transformRGB565ToBGRX8888, transformRGB565ToBGRX8888N, pixels, iterations);
+	benchmark<RGBA8888ToBGRA8888Kernel>("RGBA8888 -> BGRA8888",
+		transformRGBA8888ToBGRA8888, transformRGBA8888ToBGRA8888N, pixels, iterations);
+	return 0;
+}